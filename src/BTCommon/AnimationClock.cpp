@@ -0,0 +1,53 @@
+#include "BTCommon/AnimationClock.h"
+#include "BTCommon/GraphicsEntity.h"
+
+AnimationClock::AnimationClock(QObject *parent)
+	: QObject(parent)
+{
+	timer = new QTimer(this);
+	timer->setInterval(FRAME_INTERVAL);
+	timer->setTimerType(Qt::PreciseTimer);
+	connect(timer, &QTimer::timeout, this, &AnimationClock::tick);
+}
+
+/* static member */
+AnimationClock & AnimationClock::getInstance()
+{
+	static AnimationClock *instance = new AnimationClock(QCoreApplication::instance());
+	return *instance;
+}
+
+/* static member */
+void AnimationClock::add(GraphicsEntity *entity)
+{
+	AnimationClock &clock = getInstance();
+	clock.entities.insert(entity);
+	if (!clock.timer->isActive()) {
+		clock.frameTimer.start();
+		clock.timer->start();
+	}
+}
+
+/* static member */
+void AnimationClock::remove(GraphicsEntity *entity)
+{
+	AnimationClock &clock = getInstance();
+	clock.entities.remove(entity);
+	if (clock.entities.isEmpty())
+		clock.timer->stop();
+}
+
+/* static member */
+bool AnimationClock::isRunning()
+{
+	return getInstance().timer->isActive();
+}
+
+void AnimationClock::tick()
+{
+	int elapsed = frameTimer.restart();
+	// entities may unregister themselves when they reach their destination
+	for (GraphicsEntity *entity : entities.toList())
+		if (entities.contains(entity))
+			entity->animate(elapsed);
+}
@@ -0,0 +1,40 @@
+#ifndef ANIMATION_CLOCK_H
+#define ANIMATION_CLOCK_H
+
+#include <QtWidgets>
+
+class GraphicsEntity;
+
+/**
+ * \class AnimationClock
+ * A single frame scheduler shared by all moving GraphicsEntities.
+ * Each frame, every registered entity is advanced by the time elapsed since the previous frame.
+ * The timer runs only while at least one entity is registered.
+ */
+class AnimationClock : public QObject
+{
+Q_OBJECT;
+
+public:
+	static void add(GraphicsEntity *entity);
+	static void remove(GraphicsEntity *entity);
+	static bool isRunning();
+
+private:
+	AnimationClock(QObject *parent = nullptr);
+	AnimationClock(const AnimationClock &) = delete;
+	void operator = (const AnimationClock &) = delete;
+
+	static AnimationClock & getInstance();
+
+	static const int FRAME_INTERVAL = 16;					/**< Time between frames in ms. */
+
+	QTimer *timer;
+	QElapsedTimer frameTimer;						/**< Measures time elapsed since the previous frame. */
+	QSet <GraphicsEntity *> entities;
+
+private slots:
+	void tick();
+};
+
+#endif // ANIMATION_CLOCK_H
@@ -52,6 +52,19 @@ void BTMapManager::initCentralWindow()
 	connect(map, &GraphicsMap::hexDisplayChanged, infoBar, &InfoBar::updateHexWindow);
 	connect(map, &GraphicsMap::mechInfoNeeded,    infoBar, &InfoBar::setMech);
 	connect(map, &GraphicsMap::mechInfoNotNeeded, infoBar, &InfoBar::removeMech);
+	connect(map, &GraphicsMap::mapCleared,        infoBar, &InfoBar::clear);
+
+	loadProgressDialog = new QProgressDialog(this);
+	loadProgressDialog->setWindowModality(Qt::WindowModal);
+	loadProgressDialog->setCancelButton(nullptr);
+	loadProgressDialog->setMinimumDuration(LOAD_PROGRESS_DELAY);
+	loadProgressDialog->setLabelText(BTech::Strings::LoadingMap);
+	loadProgressDialog->setRange(0, 0);
+	loadProgressDialog->reset();
+
+	connect(map, &GraphicsMap::mapHasBeenLoaded, this, &BTMapManager::onMapLoaded);
+	connect(map, &GraphicsMap::mapLoadStarted,   this, &BTMapManager::onMapLoadStarted);
+	connect(map, &GraphicsMap::mapLoadFailed,    this, &BTMapManager::onMapLoadFailed);
 }
 
 void BTMapManager::initMenu()
@@ -122,14 +135,32 @@ void BTMapManager::wheelEvent(QWheelEvent *event)
 
 void BTMapManager::onLoadMapAction()
 {
-	if (!map->loadMap(QFileDialog::getOpenFileName(this,
-	                                               BTech::Strings::DialogOpenFile,
-	                                               BTech::Paths::MAPS_PATH,
-	                                               BTech::Strings::DialogBTechMapFiles)))
-		return;
+	map->loadMap(QFileDialog::getOpenFileName(this,
+	                                          BTech::Strings::DialogOpenFile,
+	                                          BTech::Paths::MAPS_PATH,
+	                                          BTech::Strings::DialogBTechMapFiles));
+}
+
+void BTMapManager::onMapLoaded()
+{
+	loadProgressDialog->reset();
 	startMapManagement();
 }
 
+/**
+ * The file is read on a worker thread, which reports no progress, so the dialog only shows that it is busy.
+ * It is shown if reading takes longer than LOAD_PROGRESS_DELAY, and hidden when the map is loaded or fails to.
+ */
+void BTMapManager::onMapLoadStarted()
+{
+	loadProgressDialog->setValue(0);
+}
+
+void BTMapManager::onMapLoadFailed()
+{
+	loadProgressDialog->reset();
+}
+
 void BTMapManager::onQuitAction()
 {
 	close();
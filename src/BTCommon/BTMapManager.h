@@ -24,6 +24,7 @@ protected:
 
 	GraphicsMap *map;
 	InfoBar *infoBar;
+	QProgressDialog *loadProgressDialog;
 
 	void initBaseFunctions();
 	void initWindow();
@@ -39,11 +40,16 @@ protected:
 
 	void wheelEvent(QWheelEvent *event);
 
+	static const int LOAD_PROGRESS_DELAY = 500;				/**< Loads shorter than this (in ms) show no progress dialog. */
+
 protected slots:
 	virtual void onLoadMapAction();
 	virtual void onQuitAction();
+	virtual void onMapLoaded();
 
 private slots:
+	void onMapLoadStarted();
+	void onMapLoadFailed();
 	void onShowGridAction();
 	void onShowCoordsAction();
 	void onShowInfoBarAction();
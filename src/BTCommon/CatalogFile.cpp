@@ -0,0 +1,124 @@
+#include "BTCommon/CatalogFile.h"
+
+CatalogFile::CatalogFile()
+	: mapping(nullptr), recordsStart(0)
+{}
+
+CatalogFile::~CatalogFile()
+{
+	close();
+}
+
+/**
+ * Reads the index of given file. Returns false if it is not a version 2 catalog.
+ */
+bool CatalogFile::open(const QString &fileName)
+{
+	close();
+
+	file.setFileName(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+	mapping = file.map(0, file.size());
+	if (mapping == nullptr) {
+		file.close();
+		return false;
+	}
+
+	QDataStream in(QByteArray::fromRawData(reinterpret_cast<const char *>(mapping), file.size()));
+	quint32 magic = 0;
+	quint16 version = 0;
+	in >> magic >> version;
+	if (magic != FILE_MAGIC || version > FILE_VERSION) {
+		close();
+		return false;
+	}
+
+	readSection(in, weapons);
+	readSection(in, mechs);
+	if (in.status() != QDataStream::Ok) {
+		qWarning() << "Catalog" << fileName << "is corrupted";
+		close();
+		return false;
+	}
+	recordsStart = in.device()->pos();
+
+	qDebug() << "Catalog opened:" << weapons.entries.size() << "weapons," << mechs.entries.size() << "mechs";
+	return true;
+}
+
+bool CatalogFile::isOpen() const
+{
+	return mapping != nullptr;
+}
+
+void CatalogFile::close()
+{
+	if (mapping != nullptr)
+		file.unmap(mapping);
+	mapping = nullptr;
+	file.close();
+	recordsStart = 0;
+	weapons = Section();
+	mechs = Section();
+}
+
+const CatalogFile::Section & CatalogFile::getWeapons() const
+{
+	return weapons;
+}
+
+const CatalogFile::Section & CatalogFile::getMechs() const
+{
+	return mechs;
+}
+
+/**
+ * Returns the record of given entry. The data is not copied, so it is valid only while the file is open.
+ */
+QByteArray CatalogFile::read(const Entry &entry) const
+{
+	if (mapping == nullptr || recordsStart + entry.offset + entry.size > file.size()) {
+		qWarning() << "Warning: record" << entry.name << "is out of the catalog";
+		return QByteArray();
+	}
+	return QByteArray::fromRawData(reinterpret_cast<const char *>(mapping) + recordsStart + entry.offset, entry.size);
+}
+
+/* static member */
+void CatalogFile::write(QDataStream &out, UID nextWeaponUid, const QList <Record> &weapons,
+                        UID nextMechUid, const QList <Record> &mechs)
+{
+	out << FILE_MAGIC << FILE_VERSION;
+
+	quint32 offset = 0;
+	writeSection(out, nextWeaponUid, weapons, offset);
+	writeSection(out, nextMechUid, mechs, offset);
+
+	for (const Record &record : weapons)
+		out.writeRawData(record.data.constData(), record.data.size());
+	for (const Record &record : mechs)
+		out.writeRawData(record.data.constData(), record.data.size());
+}
+
+/* static member */
+void CatalogFile::writeSection(QDataStream &out, UID nextUid, const QList <Record> &records, quint32 &offset)
+{
+	out << nextUid << static_cast<quint32>(records.size());
+	for (const Record &record : records) {
+		out << record.uid << record.name << offset << static_cast<quint32>(record.data.size());
+		offset += record.data.size();
+	}
+}
+
+/* static member */
+void CatalogFile::readSection(QDataStream &in, Section &section)
+{
+	quint32 count;
+	in >> section.nextUid >> count;
+	for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+		Entry entry;
+		in >> entry.uid >> entry.name >> entry.offset >> entry.size;
+		section.entries << entry;
+	}
+}
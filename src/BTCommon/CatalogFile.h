@@ -0,0 +1,93 @@
+#ifndef CATALOG_FILE_H
+#define CATALOG_FILE_H
+
+#include <QtCore>
+#include "BTCommon/Uid.h"
+
+/**
+ * \class CatalogFile
+ * Version 2 of the data file. A header holds an index of weapons and mechs (UID, name, and position of each record),
+ * followed by the records themselves. Opening the file reads only the header; the file stays memory-mapped
+ * and single records are read when the models ask for them.
+ */
+class CatalogFile
+{
+
+public:
+	/**
+	 * \struct Entry
+	 * Position of a single record, relative to the beginning of the records.
+	 */
+	struct Entry {
+		UID uid;
+		QString name;
+		quint32 offset;
+		quint32 size;
+	};
+
+	/**
+	 * \struct Section
+	 * Index of all records of one kind.
+	 */
+	struct Section {
+		UID nextUid = 0;
+		QList <Entry> entries;
+	};
+
+	/**
+	 * \struct Record
+	 * Serialized object, as written to the file.
+	 */
+	struct Record {
+		UID uid;
+		QString name;
+		QByteArray data;
+	};
+
+	CatalogFile();
+	~CatalogFile();
+
+	bool open(const QString &fileName);
+	bool isOpen() const;
+	void close();
+
+	const Section & getWeapons() const;
+	const Section & getMechs() const;
+	QByteArray read(const Entry &entry) const;
+
+	template <typename T>
+	static Record makeRecord(UID uid, const QString &name, const T &object);
+	static void write(QDataStream &out, UID nextWeaponUid, const QList <Record> &weapons,
+	                  UID nextMechUid, const QList <Record> &mechs);
+
+private:
+	CatalogFile(const CatalogFile &) = delete;
+	void operator = (const CatalogFile &) = delete;
+
+	QFile file;
+	uchar *mapping;
+	qint64 recordsStart;							/**< Offset of the first record in the file. */
+
+	Section weapons;
+	Section mechs;
+
+	static void writeSection(QDataStream &out, UID nextUid, const QList <Record> &records, quint32 &offset);
+	static void readSection(QDataStream &in, Section &section);
+
+	static const quint32 FILE_MAGIC = 0x42544443;				/**< "BTDC"; version 1 files start with the next weapon UID. */
+	static const quint16 FILE_VERSION = 2;
+};
+
+/**
+ * Serializes given object into a record, so it can be written to the catalog.
+ */
+template <typename T>
+CatalogFile::Record CatalogFile::makeRecord(UID uid, const QString &name, const T &object)
+{
+	Record record {uid, name, QByteArray()};
+	QDataStream out(&record.data, QIODevice::WriteOnly);
+	out << object;
+	return record;
+}
+
+#endif // CATALOG_FILE_H
@@ -0,0 +1,461 @@
+#include "BTCommon/CatalogImporter.h"
+
+const QStringList CatalogImporter::WEAPON_FIELDS {
+	"name", "type", "minRange", "shortRange", "mediumRange", "longRange",
+	"heat", "damage", "tonnage", "criticalSpaces", "ammoPerTon", "missilesPerShot"
+};
+
+const QStringList CatalogImporter::MECH_FIELDS {
+	"type", "tonnage", "armorValue", "maxMovePoints", "maxJumpPoints", "baseFireRange", "heatSinksNumber",
+	"contactRangeDamage", "shortRangeDamage", "mediumRangeDamage", "longRangeDamage"
+};
+
+const QStringList CatalogImporter::PART_FIELDS {
+	"type", "side", "maxArmorValue", "maxInternalValue", "weapons"
+};
+
+namespace {
+
+/**
+ * \class ImportTask
+ * Runs given task for a range of record indexes.
+ */
+class ImportTask : public QRunnable
+{
+public:
+	ImportTask(const std::function<void (int)> &task, int begin, int end)
+		: task(task), begin(begin), end(end)
+	{}
+
+	void run()
+	{
+		for (int i = begin; i < end; ++i)
+			task(i);
+	}
+
+private:
+	const std::function<void (int)> &task;
+	int begin;
+	int end;
+};
+
+/**
+ * Reads given fields as non-negative integers. Returns the first field that is not one, or an empty string.
+ */
+QString readNumbers(const QVariantMap &fields, const QStringList &keys, QHash <QString, int> &numbers)
+{
+	for (const QString &key : keys) {
+		const QVariant value = fields.value(key);
+		bool ok;
+		int number = value.toInt(&ok);
+		// JSON numbers are doubles, which toInt() would silently round
+		if (value.type() == QVariant::Double && value.toDouble() != number)
+			ok = false;
+		if (!ok || number < 0)
+			return key;
+		numbers[key] = number;
+	}
+	return QString();
+}
+
+}
+
+/* static member */
+CatalogImporter::Format CatalogImporter::getFormat(const QString &fileName)
+{
+	if (QFileInfo(fileName).suffix().toLower() == "json")
+		return Format::Json;
+	return Format::Csv;
+}
+
+bool CatalogImporter::importFile(const QString &fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		errors = QStringList(QString("Cannot open %1").arg(fileName));
+		return false;
+	}
+	return import(file.readAll(), getFormat(fileName));
+}
+
+/**
+ * Reads, validates and adds all records. Returns false only if the data could not be read at all;
+ * rejected records are listed by getErrors().
+ */
+bool CatalogImporter::import(const QByteArray &data, Format format)
+{
+	weaponRecords.clear();
+	mechRecords.clear();
+	errors.clear();
+	importedWeapons = 0;
+	importedMechs = 0;
+
+	if (!(format == Format::Json ? readJson(data) : readCsv(data)))
+		return false;
+
+	// models are not modified while the tasks run, so they may be read from all threads
+	QVector <WeaponBase *> builtWeapons(weaponRecords.size());
+	QVector <QString> weaponErrors(weaponRecords.size());
+	WeaponBase **weaponSlots = builtWeapons.data();
+	QString *weaponErrorSlots = weaponErrors.data();
+	runParallel(weaponRecords.size(), [&](int i) {
+		weaponSlots[i] = buildWeapon(weaponRecords[i], weaponErrorSlots[i]);
+	});
+
+	QList <WeaponBase *> weapons;
+	QSet <QString> weaponNames;
+	for (int i = 0; i < weaponRecords.size(); ++i) {
+		WeaponBase *weapon = builtWeapons[i];
+		if (weapon == nullptr) {
+			addError("weapon", weaponRecords[i].line, weaponErrors[i]);
+		} else if (weaponNames.contains(weapon->getName()) || WeaponModel::hasWeapon(weapon->getName())) {
+			addError("weapon", weaponRecords[i].line, QString("weapon %1 already exists").arg(weapon->getName()));
+			delete weapon;
+		} else {
+			weaponNames << weapon->getName();
+			weapons << weapon;
+		}
+	}
+
+	QVector <BuiltMech> builtMechs(mechRecords.size());
+	QVector <QString> mechErrors(mechRecords.size());
+	BuiltMech *mechSlots = builtMechs.data();
+	QString *mechErrorSlots = mechErrors.data();
+	runParallel(mechRecords.size(), [&](int i) {
+		mechSlots[i] = buildMech(mechRecords[i], weaponNames, mechErrorSlots[i]);
+	});
+
+	QList <BuiltMech> mechs;
+	QSet <QString> mechTypes;
+	for (int i = 0; i < mechRecords.size(); ++i) {
+		MechBase *mech = builtMechs[i].mech;
+		if (mech == nullptr) {
+			addError("mech", mechRecords[i].line, mechErrors[i]);
+		} else if (mechTypes.contains(mech->getType()) || MechModel::hasMech(mech->getType())) {
+			addError("mech", mechRecords[i].line, QString("mech %1 already exists").arg(mech->getType()));
+			delete mech;
+		} else {
+			mechTypes << mech->getType();
+			mechs << builtMechs[i];
+		}
+	}
+
+	WeaponModel::importWeapons(weapons);
+	importedWeapons = weapons.size();
+
+	QList <MechBase *> mechList;
+	for (const BuiltMech &built : mechs) {
+		for (const QPair <MechPartBase *, QStringList> &part : built.partWeapons)
+			for (const QString &name : part.second)
+				part.first->addWeapon(WeaponModel::getWeapon(name));
+		mechList << built.mech;
+	}
+	MechModel::importMechs(mechList);
+	importedMechs = mechList.size();
+
+	return true;
+}
+
+int CatalogImporter::getImportedWeapons() const
+{
+	return importedWeapons;
+}
+
+int CatalogImporter::getImportedMechs() const
+{
+	return importedMechs;
+}
+
+const QStringList & CatalogImporter::getErrors() const
+{
+	return errors;
+}
+
+/**
+ * Parts are gathered into the "parts" list of the mech they name, so mechs can be validated independently.
+ */
+bool CatalogImporter::readCsv(const QByteArray &data)
+{
+	QTextStream stream(data);
+	QHash <QString, int> mechRows;
+	QList <QPair <int, QStringList> > partLines;
+
+	for (int line = 1; !stream.atEnd(); ++line) {
+		QString text = stream.readLine();
+		if (text.trimmed().isEmpty() || text.startsWith('#'))
+			continue;
+
+		QStringList values = splitCsvLine(text);
+		QString kind = values.value(0).trimmed().toLower();
+		if (!values.isEmpty())
+			values.removeFirst();
+		if (kind == "weapon") {
+			weaponRecords << Record{line, toFields(WEAPON_FIELDS, values)};
+		} else if (kind == "mech") {
+			mechRows.insert(values.value(0).trimmed(), mechRecords.size());
+			mechRecords << Record{line, toFields(MECH_FIELDS, values)};
+		} else if (kind == "part") {
+			partLines << qMakePair(line, values);
+		} else {
+			addError("line", line, QString("unknown record kind %1").arg(kind));
+		}
+	}
+
+	for (QPair <int, QStringList> &partLine : partLines) {
+		QString mechType = partLine.second.value(0).trimmed();
+		if (mechType.isEmpty()) {
+			addError("part", partLine.first, "malformed line, no mech given");
+			continue;
+		}
+		partLine.second.removeFirst();
+
+		auto it = mechRows.constFind(mechType);
+		if (it == mechRows.constEnd()) {
+			addError("part", partLine.first, QString("unknown mech %1").arg(mechType));
+			continue;
+		}
+
+		QVariantMap part = toFields(PART_FIELDS, partLine.second);
+		QStringList weapons;
+		for (const QString &name : part.value("weapons").toString().split(';', QString::SkipEmptyParts))
+			weapons << name.trimmed();
+		part["weapons"] = weapons;
+
+		QVariantMap &fields = mechRecords[*it].fields;
+		QVariantList parts = fields.value("parts").toList();
+		parts << part;
+		fields["parts"] = parts;
+	}
+
+	return true;
+}
+
+bool CatalogImporter::readJson(const QByteArray &data)
+{
+	QJsonParseError parseError;
+	QJsonDocument document = QJsonDocument::fromJson(data, &parseError);
+	if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+		errors << QString("Invalid JSON: %1").arg(parseError.errorString());
+		return false;
+	}
+
+	QJsonArray weapons = document.object().value("weapons").toArray();
+	for (int i = 0; i < weapons.size(); ++i)
+		weaponRecords << Record{i + 1, weapons[i].toObject().toVariantMap()};
+
+	QJsonArray mechs = document.object().value("mechs").toArray();
+	for (int i = 0; i < mechs.size(); ++i)
+		mechRecords << Record{i + 1, mechs[i].toObject().toVariantMap()};
+
+	return true;
+}
+
+/**
+ * Splits a CSV line into fields. Fields may be quoted, with quotes inside doubled.
+ */
+/* static member */
+QStringList CatalogImporter::splitCsvLine(const QString &line)
+{
+	QStringList result;
+	QString field;
+	bool quoted = false;
+
+	for (int i = 0; i < line.size(); ++i) {
+		QChar c = line[i];
+		if (quoted) {
+			if (c != '"')
+				field += c;
+			else if (i + 1 < line.size() && line[i + 1] == '"')
+				field += line[++i];
+			else
+				quoted = false;
+		} else if (c == '"') {
+			quoted = true;
+		} else if (c == ',') {
+			result << field;
+			field.clear();
+		} else {
+			field += c;
+		}
+	}
+	result << field;
+
+	return result;
+}
+
+/* static member */
+QVariantMap CatalogImporter::toFields(const QStringList &keys, const QStringList &values)
+{
+	QVariantMap fields;
+	for (int i = 0; i < keys.size() && i < values.size(); ++i)
+		fields[keys[i]] = values[i].trimmed();
+	return fields;
+}
+
+/**
+ * Returns the weapon described by the record, or nullptr with error set if it is not valid.
+ * Range thresholds have to grow and stay within BTech::minimalMaxRange and BTech::maximalMaxRange, as in EditWeaponsDialog.
+ */
+/* static member */
+WeaponBase * CatalogImporter::buildWeapon(const Record &record, QString &error)
+{
+	const QVariantMap &fields = record.fields;
+
+	QString name = fields.value("name").toString().trimmed();
+	if (name.isEmpty()) {
+		error = "empty name";
+		return nullptr;
+	}
+
+	QString typeName = fields.value("type").toString();
+	BTech::WeaponType type = BTech::weaponTypeStringChange[typeName];
+	if (BTech::weaponTypeStringChange[type] != typeName) {
+		error = QString("unknown weapon type %1").arg(typeName);
+		return nullptr;
+	}
+
+	QHash <QString, int> numbers;
+	QString invalid = readNumbers(fields, WEAPON_FIELDS.mid(2), numbers);
+	if (!invalid.isEmpty()) {
+		error = QString("%1 is not a non-negative integer").arg(invalid);
+		return nullptr;
+	}
+
+	const QHash <BTech::Range, QString> rangeFields {
+		{BTech::Range::Short,  "shortRange"},
+		{BTech::Range::Medium, "mediumRange"},
+		{BTech::Range::Long,   "longRange"},
+	};
+	int previous = 0;
+	for (BTech::Range range : BTech::shootRanges) {
+		int maxRange = numbers[rangeFields[range]];
+		if (maxRange < BTech::minimalMaxRange[range] || maxRange > BTech::maximalMaxRange[range]) {
+			error = QString("%1 %2 is out of range [%3, %4]").arg(rangeFields[range]).arg(maxRange)
+				.arg(BTech::minimalMaxRange[range]).arg(BTech::maximalMaxRange[range]);
+			return nullptr;
+		}
+		if (maxRange <= previous) {
+			error = QString("%1 is not greater than the shorter range").arg(rangeFields[range]);
+			return nullptr;
+		}
+		previous = maxRange;
+	}
+	if (numbers["minRange"] > previous) {
+		error = "minRange is greater than longRange";
+		return nullptr;
+	}
+	if (numbers["ammoPerTon"] > WeaponBase::MAX_AMMO_SHOTS_PER_TON) {
+		error = QString("ammoPerTon is greater than %1").arg(WeaponBase::MAX_AMMO_SHOTS_PER_TON);
+		return nullptr;
+	}
+	if (numbers["missilesPerShot"] < 1) {
+		error = "missilesPerShot is less than 1";
+		return nullptr;
+	}
+
+	return new WeaponBase(name, type,
+	                      numbers["minRange"], numbers["shortRange"], numbers["mediumRange"], numbers["longRange"],
+	                      numbers["heat"], numbers["damage"], numbers["tonnage"], numbers["criticalSpaces"],
+	                      numbers["ammoPerTon"], numbers["missilesPerShot"]);
+}
+
+/**
+ * Returns the mech described by the record, or no mech with error set if it is not valid.
+ * Weapons of its parts have to be either imported along with it or already in WeaponModel.
+ */
+/* static member */
+CatalogImporter::BuiltMech CatalogImporter::buildMech(const Record &record, const QSet <QString> &importedWeapons, QString &error)
+{
+	const QVariantMap &fields = record.fields;
+	BuiltMech result;
+
+	QString type = fields.value("type").toString().trimmed();
+	if (type.isEmpty()) {
+		error = "empty type";
+		return result;
+	}
+
+	QHash <QString, int> numbers;
+	QString invalid = readNumbers(fields, MECH_FIELDS.mid(1), numbers);
+	if (!invalid.isEmpty()) {
+		error = QString("%1 is not a non-negative integer").arg(invalid);
+		return result;
+	}
+
+	QScopedPointer <MechBase> mech(new MechBase(type, EmptyUid));
+	mech->setTonnage(numbers["tonnage"]);
+	mech->setArmorValue(numbers["armorValue"]);
+	mech->setMaxMovePoints(numbers["maxMovePoints"]);
+	mech->setMaxJumpPoints(numbers["maxJumpPoints"]);
+	mech->setBaseFireRange(numbers["baseFireRange"]);
+	mech->setHeatSinksNumber(numbers["heatSinksNumber"]);
+	mech->setRangeDamage(BTech::Range::Contact, numbers["contactRangeDamage"]);
+	mech->setRangeDamage(BTech::Range::Short,   numbers["shortRangeDamage"]);
+	mech->setRangeDamage(BTech::Range::Medium,  numbers["mediumRangeDamage"]);
+	mech->setRangeDamage(BTech::Range::Long,    numbers["longRangeDamage"]);
+
+	for (const QVariant &partValue : fields.value("parts").toList()) {
+		QVariantMap partFields = partValue.toMap();
+
+		QString typeName = partFields.value("type").toString();
+		QString sideName = partFields.value("side").toString();
+		BTech::MechPartType partType = BTech::mechPartTypeStringChange[typeName];
+		BTech::MechPartSide partSide = BTech::mechPartSideStringChange[sideName];
+		if (BTech::mechPartTypeStringChange[partType] != typeName || BTech::mechPartSideStringChange[partSide] != sideName) {
+			error = QString("unknown part %1 %2").arg(sideName).arg(typeName);
+			return result;
+		}
+
+		MechPartBase *part = nullptr;
+		for (MechPartBase *mechPart : mech->getMechParts())
+			if (mechPart->getType() == partType && mechPart->getSide() == partSide)
+				part = mechPart;
+		if (part == nullptr) {
+			error = QString("mechs have no part %1 %2").arg(sideName).arg(typeName);
+			return result;
+		}
+
+		QHash <QString, int> partNumbers;
+		invalid = readNumbers(partFields, {"maxArmorValue", "maxInternalValue"}, partNumbers);
+		if (!invalid.isEmpty()) {
+			error = QString("%1 of %2 %3 is not a non-negative integer").arg(invalid).arg(sideName).arg(typeName);
+			return result;
+		}
+		if (partNumbers["maxArmorValue"] < MechPartBase::MINIMAL_ARMOR_VALUE
+		    || partNumbers["maxInternalValue"] < MechPartBase::MINIMAL_INTERNAL_VALUE) {
+			error = QString("armor and internal values of %1 %2 have to be positive").arg(sideName).arg(typeName);
+			return result;
+		}
+		part->setMaxArmorValue(partNumbers["maxArmorValue"]);
+		part->setMaxInternalValue(partNumbers["maxInternalValue"]);
+
+		QStringList weapons = partFields.value("weapons").toStringList();
+		for (const QString &name : weapons) {
+			if (!importedWeapons.contains(name) && !WeaponModel::hasWeapon(name)) {
+				error = QString("unknown weapon %1").arg(name);
+				return result;
+			}
+		}
+		result.partWeapons << qMakePair(part, weapons);
+	}
+
+	result.mech = mech.take();
+	return result;
+}
+
+/**
+ * Calls task for every index from 0 to count - 1, in chunks spread over a thread pool. Returns when all are done.
+ */
+/* static member */
+void CatalogImporter::runParallel(int count, const std::function<void (int)> &task)
+{
+	QThreadPool pool;
+	for (int begin = 0; begin < count; begin += RECORDS_PER_TASK)
+		pool.start(new ImportTask(task, begin, qMin(count, begin + RECORDS_PER_TASK)));
+	pool.waitForDone();
+}
+
+void CatalogImporter::addError(const QString &kind, int line, const QString &error)
+{
+	errors << QString("%1 %2: %3").arg(kind).arg(line).arg(error);
+}
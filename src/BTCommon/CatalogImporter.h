@@ -0,0 +1,83 @@
+#ifndef CATALOG_IMPORTER_H
+#define CATALOG_IMPORTER_H
+
+#include <QtCore>
+#include <functional>
+#include "BTCommon/MechBase.h"
+#include "BTCommon/WeaponBase.h"
+
+/**
+ * \class CatalogImporter
+ * Imports many weapons and mechs at once from a CSV or JSON file.
+ *
+ * Records are built and validated on worker threads; those that pass are then added to WeaponModel
+ * and MechModel with a single model reset each. Invalid or duplicated records are skipped and reported.
+ *
+ * JSON files contain an object with "weapons" and "mechs" arrays; their objects use the keys listed in
+ * WEAPON_FIELDS, MECH_FIELDS and PART_FIELDS, a mech having its parts in a "parts" array.
+ * In CSV files, the first column tells what a line describes ("weapon", "mech" or "part") and the other columns
+ * follow the same lists. A part line names its mech first and lists its weapons separated by semicolons.
+ * Empty lines and lines starting with '#' are skipped.
+ */
+class CatalogImporter
+{
+
+public:
+	enum class Format : quint8 {
+		Csv,
+		Json
+	};
+
+	static Format getFormat(const QString &fileName);
+
+	bool importFile(const QString &fileName);
+	bool import(const QByteArray &data, Format format);
+
+	int getImportedWeapons() const;
+	int getImportedMechs() const;
+	const QStringList & getErrors() const;
+
+private:
+	/**
+	 * \struct Record
+	 * One weapon or mech, as read from the file, before validation.
+	 */
+	struct Record {
+		int line;							/**< Line in CSV files, position in the array in JSON files. */
+		QVariantMap fields;
+	};
+
+	/**
+	 * \struct BuiltMech
+	 * A mech whose parts do not have their weapons yet; the names are resolved once weapons are in WeaponModel.
+	 */
+	struct BuiltMech {
+		MechBase *mech = nullptr;
+		QList <QPair <MechPartBase *, QStringList> > partWeapons;
+	};
+
+	QList <Record> weaponRecords;
+	QList <Record> mechRecords;
+	QStringList errors;
+	int importedWeapons = 0;
+	int importedMechs = 0;
+
+	bool readCsv(const QByteArray &data);
+	bool readJson(const QByteArray &data);
+	static QStringList splitCsvLine(const QString &line);
+	static QVariantMap toFields(const QStringList &keys, const QStringList &values);
+
+	static WeaponBase * buildWeapon(const Record &record, QString &error);
+	static BuiltMech buildMech(const Record &record, const QSet <QString> &importedWeapons, QString &error);
+
+	static void runParallel(int count, const std::function<void (int)> &task);
+
+	void addError(const QString &kind, int line, const QString &error);
+
+	static const QStringList WEAPON_FIELDS;
+	static const QStringList MECH_FIELDS;
+	static const QStringList PART_FIELDS;
+	static const int RECORDS_PER_TASK = 256;				/**< Records are validated in chunks of that size, one chunk per task. */
+};
+
+#endif // CATALOG_IMPORTER_H
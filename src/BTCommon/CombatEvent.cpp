@@ -0,0 +1,108 @@
+#include "BTCommon/EnumHashFunctions.h"
+
+#include "BTCommon/CombatEvent.h"
+#include "BTCommon/Position.h"
+#include "BTCommon/WeaponBase.h"
+
+/**
+ * \class CombatEvent
+ */
+
+CombatEvent::CombatEvent(Type type, int first, int second)
+	: type(type), first(first), second(second)
+{}
+
+CombatEvent::CombatEvent(Type type, const QString &unitName, const QString &ownerName)
+	: type(type), first(0), second(0), unitName(unitName), ownerName(ownerName)
+{}
+
+CombatEvent::CombatEvent(const Effect &effect)
+	: type(Type::Effect), first(0), second(0), effect(effect)
+{}
+
+CombatEvent::Type CombatEvent::getType() const
+{
+	return type;
+}
+
+int CombatEvent::getFirst() const
+{
+	return first;
+}
+
+int CombatEvent::getSecond() const
+{
+	return second;
+}
+
+QString CombatEvent::getUnitName() const
+{
+	return unitName;
+}
+
+QString CombatEvent::getOwnerName() const
+{
+	return ownerName;
+}
+
+Effect CombatEvent::getEffect() const
+{
+	return effect;
+}
+
+CombatEvent::operator QString() const
+{
+	switch (type) {
+		case Type::Signature:
+			return unitName + " (" + ownerName + ")";
+		case Type::MovedToHex:
+			return QString(" ") + BTech::ExtInfo::MovedToHex.arg(first);
+		case Type::AttackedBy:
+			return BTech::ExtInfo::AttackedBy.arg(unitName).arg(ownerName);
+		case Type::AttackModifierCheck:
+			return BTech::ExtInfo::AttackModifierCheck;
+		case Type::ArmorPenetrationCheck:
+			return BTech::ExtInfo::ArmorPenetrationCheck;
+		case Type::DeterminingHitLocation:
+			return BTech::ExtInfo::DeterminingHitLocation;
+		case Type::D2Roll:
+			return BTech::ExtInfo::DisplayD2Roll.arg(first);
+		case Type::Modifier:
+			return BTech::ExtInfo::DisplayValue
+				.arg(BTech::modifierStringChange[static_cast<BTech::Modifier>(first)])
+				.arg(second);
+		case Type::GeneralModifier:
+			return BTech::ExtInfo::DisplayGeneralModifier.arg(first);
+		case Type::AttackDirection:
+			return BTech::ExtInfo::DisplayAttackDirection.arg(BTech::directionSideStringChange[Direction(first)]);
+		case Type::Sum:
+			return BTech::ExtInfo::SumOfTwoValues.arg(first).arg(second).arg(first + second);
+		case Type::Difference:
+			return BTech::ExtInfo::SubstractionOfTwoValues.arg(first).arg(second).arg(first - second);
+		case Type::Hit:
+			return BTech::ExtInfo::Hit;
+		case Type::AttackMissed:
+			return BTech::ExtInfo::AttackMissed;
+		case Type::ArmorPenetrated:
+			return BTech::ExtInfo::ArmorPenetrated;
+		case Type::AttackDeflected:
+			return BTech::ExtInfo::AttackDeflected;
+		case Type::Critical:
+			return BTech::ExtInfo::Critical;
+		case Type::HitPart: {
+			BTech::MechPartType partType = static_cast<BTech::MechPartType>(first);
+			BTech::MechPartSide partSide = static_cast<BTech::MechPartSide>(second);
+			QString sideString;
+			if (partSide != BTech::MechPartSide::General)
+				sideString = BTech::mechPartSideStringChange[partSide];
+			return BTech::ExtInfo::HitPart
+				.arg(sideString)
+				.arg(BTech::mechPartTypeStringChange[partType]);
+		}
+		case Type::ListEffects:
+			return BTech::ExtInfo::ListEffects;
+		case Type::Effect:
+			return QString(effect);
+	}
+	return QString();
+}
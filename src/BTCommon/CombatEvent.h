@@ -0,0 +1,61 @@
+#ifndef COMBAT_EVENT_H
+#define COMBAT_EVENT_H
+
+#include <QtWidgets>
+#include "BTCommon/Effect.h"
+#include "BTCommon/Utils.h"
+
+/**
+ * \class CombatEvent
+ * Compact record of a single step of movement or combat resolution (a roll, a modifier, a hit location, an effect...).
+ * Events carry raw values only; they are turned into text by the consumer, when it actually displays them.
+ */
+class CombatEvent
+{
+public:
+	enum class Type : quint8 {
+		Signature,
+		MovedToHex,
+		AttackedBy,
+		AttackModifierCheck,
+		ArmorPenetrationCheck,
+		DeterminingHitLocation,
+		D2Roll,
+		Modifier,
+		GeneralModifier,
+		AttackDirection,
+		Sum,
+		Difference,
+		Hit,
+		AttackMissed,
+		ArmorPenetrated,
+		AttackDeflected,
+		Critical,
+		HitPart,
+		ListEffects,
+		Effect,
+	};
+
+	CombatEvent(Type type = Type::Signature, int first = 0, int second = 0);
+	CombatEvent(Type type, const QString &unitName, const QString &ownerName);
+	CombatEvent(const Effect &effect);
+
+	Type getType() const;
+	int getFirst() const;
+	int getSecond() const;
+	QString getUnitName() const;
+	QString getOwnerName() const;
+	Effect getEffect() const;
+
+	explicit operator QString() const;
+
+private:
+	Type type;
+	int first;
+	int second;
+	QString unitName;
+	QString ownerName;
+	Effect effect;
+};
+
+#endif // COMBAT_EVENT_H
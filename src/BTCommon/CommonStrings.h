@@ -102,6 +102,8 @@ namespace BTech {
 		const QString DialogBTechMapFilesExtension = QObject::tr("btm");
 		const QString DialogBTechMapFiles          = QObject::tr("BTech Map files (*.%1)").arg(DialogBTechMapFilesExtension);
 
+		const QString LoadingMap = QObject::tr("Loading map...");
+
 		const QString LabelArmor      = QObject::tr("Armor");
 		const QString LabelDamage     = QObject::tr("Damage");
 		const QString LabelHeight     = QObject::tr("Height");
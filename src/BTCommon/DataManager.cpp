@@ -8,15 +8,37 @@ DataManager & DataManager::getInstance()
 	return *dataManager;
 }
 
+/**
+ * Files without the catalog header are read as a whole, as version 1.
+ */
 bool DataManager::loadFromFile(const QString &fileName = BTech::Paths::DATA_PATH)
 {
-	return ::loadFromFile(getInstance(), fileName);
+	DataManager &dataManager = getInstance();
+	if (dataManager.catalog.isOpen()) {
+		// entries not read yet would refer to the closed file
+		WeaponModel::loadAll();
+		MechModel::loadAll();
+	}
+
+	FileWriter::waitForFinished();
+	if (dataManager.catalog.open(fileName)) {
+		WeaponModel::attachCatalog(&dataManager.catalog);
+		MechModel::attachCatalog(&dataManager.catalog);
+		return true;
+	}
+	return ::loadFromFile(dataManager, fileName);
 }
 
 bool DataManager::saveToFile(const QString &fileName = BTech::Paths::DATA_PATH)
 {
 	WeaponModel::getInstance().setChanged(false);
 	MechModel::getInstance().setChanged(false);
+
+	// all entries are read before the catalog is closed, so the file can be replaced
+	WeaponModel::loadAll();
+	MechModel::loadAll();
+	getInstance().catalog.close();
+
 	return ::saveToFile(getInstance(), fileName);
 }
 
@@ -29,7 +51,19 @@ DataManager::~DataManager()
 
 QDataStream & operator << (QDataStream &out, const DataManager &dataManager)
 {
-	out << WeaponModel::getInstance() << MechModel::getInstance();
+	QList <CatalogFile::Record> weapons;
+	for (int row = 0; row < WeaponModel::getRowCount(); ++row) {
+		const WeaponBase *weapon = WeaponModel::getRow(row);
+		weapons << CatalogFile::makeRecord(weapon->getUid(), weapon->getName(), *weapon);
+	}
+
+	QList <CatalogFile::Record> mechs;
+	for (int row = 0; row < MechModel::getRowCount(); ++row) {
+		const MechBase *mech = MechModel::getRow(row);
+		mechs << CatalogFile::makeRecord(mech->getUid(), mech->getType(), *mech);
+	}
+
+	CatalogFile::write(out, WeaponModel::getNextUid(), weapons, MechModel::getNextUid(), mechs);
 	return out;
 }
 
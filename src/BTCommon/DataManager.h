@@ -1,9 +1,15 @@
 #ifndef DATA_MANAGER_H
 #define DATA_MANAGER_H
 
+#include "BTCommon/CatalogFile.h"
 #include "BTCommon/MechBase.h"
 #include "BTCommon/WeaponBase.h"
 
+/**
+ * \class DataManager
+ * Loads and saves the weapon and mech catalog. Version 2 files are only indexed on load;
+ * the models read single entries from the catalog on first use.
+ */
 class DataManager
 {
 
@@ -27,6 +33,7 @@ private:
 	friend bool ::saveToFile<DataManager>(DataManager &obj, const QString &fileName);
 
 	bool changed;
+	CatalogFile catalog;
 };
 
 #endif // DATA_MANAGER_H
\ No newline at end of file
@@ -2,10 +2,14 @@
 #define FILEIO_HPP
 
 #include <QtCore>
+#include "BTCommon/FileWriter.h"
 
 template <typename T>
 bool loadFromFile(T &obj, const QString &fileName)
 {
+	// the file may still be waiting to be written
+	FileWriter::waitForFinished();
+
 	QFile file(fileName);
 	if (!file.open(QIODevice::ReadOnly))
 		return false;
@@ -16,31 +20,21 @@ bool loadFromFile(T &obj, const QString &fileName)
 	return true;
 }
 
+/**
+ * Serializes given object into memory and queues it to be written by the FileWriter.
+ * Returns false if the object could not be serialized; failures to write are reported by FileWriter::written().
+ */
 template <typename T>
 bool saveToFile(T &obj, const QString &fileName)
 {
-	QTemporaryFile tmpFile;
-
-	if (!tmpFile.open())
-		return false;
-
-	QDataStream output(&tmpFile);
+	QByteArray data;
+	QDataStream output(&data, QIODevice::WriteOnly);
 	output << obj;
 
-	if (!tmpFile.flush())
-		return false;
-	tmpFile.close();
-
-	if (QFile::exists(fileName)) {
-		if (QFile::exists(fileName + '~'))
-			QFile::remove(fileName + '~');
-		if (!QFile::copy(fileName, fileName + '~') || !QFile::remove(fileName))
-			return false;
-	}
-
-	if (!tmpFile.copy(fileName))
+	if (output.status() != QDataStream::Ok)
 		return false;
 
+	FileWriter::write(fileName, data);
 	return true;
 }
 
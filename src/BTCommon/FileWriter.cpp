@@ -0,0 +1,129 @@
+#include "BTCommon/FileWriter.h"
+
+FileWriter::FileWriter(QObject *parent)
+	: QThread(parent), busy(false), quitting(false)
+{}
+
+/**
+ * Writes all queued files before the thread is stopped, so saving right before quitting is safe.
+ */
+FileWriter::~FileWriter()
+{
+	mutex.lock();
+	quitting = true;
+	jobAdded.wakeAll();
+	mutex.unlock();
+	wait();
+}
+
+/* static member */
+FileWriter & FileWriter::getInstance()
+{
+	static FileWriter *instance = new FileWriter(QCoreApplication::instance());
+	return *instance;
+}
+
+/**
+ * Queues data to be written to given file. The result is reported with the written() signal.
+ */
+/* static member */
+void FileWriter::write(const QString &fileName, const QByteArray &data, int backups)
+{
+	FileWriter &writer = getInstance();
+	QMutexLocker locker(&writer.mutex);
+	writer.jobs.enqueue({fileName, data, backups});
+	writer.jobAdded.wakeOne();
+	if (!writer.isRunning())
+		writer.start(QThread::LowPriority);
+}
+
+/**
+ * Blocks until all queued files are written. Called before reading a file that may still be pending.
+ */
+/* static member */
+void FileWriter::waitForFinished()
+{
+	FileWriter &writer = getInstance();
+	QMutexLocker locker(&writer.mutex);
+	while (writer.busy || !writer.jobs.isEmpty())
+		writer.jobsFinished.wait(&writer.mutex);
+}
+
+void FileWriter::run()
+{
+	QMutexLocker locker(&mutex);
+	forever {
+		while (jobs.isEmpty() && !quitting)
+			jobAdded.wait(&mutex);
+		if (jobs.isEmpty())
+			return;
+
+		Job job = jobs.dequeue();
+		busy = true;
+		locker.unlock();
+
+		bool success = writeFile(job);
+		emit written(job.fileName, success);
+
+		locker.relock();
+		busy = false;
+		if (jobs.isEmpty())
+			jobsFinished.wakeAll();
+	}
+}
+
+/**
+ * The previous version is copied aside before the commit and the backups are shifted only after it,
+ * so the target path always holds a complete file and a failed write leaves the backups untouched.
+ */
+/* static member */
+bool FileWriter::writeFile(const Job &job)
+{
+	QSaveFile file(job.fileName);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+	if (file.write(job.data) != job.data.size()) {
+		file.cancelWriting();
+		return false;
+	}
+
+	const QString newBackup = getBackupName(job.fileName, 1) + BACKUP_TEMPORARY_SUFFIX;
+	bool hasBackup = job.backups > 0 && QFile::exists(job.fileName);
+	if (hasBackup) {
+		QFile::remove(newBackup);
+		if (!QFile::copy(job.fileName, newBackup)) {
+			file.cancelWriting();
+			return false;
+		}
+	}
+
+	if (!file.commit()) {
+		if (hasBackup)
+			QFile::remove(newBackup);
+		return false;
+	}
+
+	if (hasBackup)
+		rotateBackups(job.fileName, job.backups, newBackup);
+	return true;
+}
+
+/**
+ * Shifts existing backups by one, dropping the oldest one, and makes the given copy of the previous version the first backup.
+ */
+/* static member */
+void FileWriter::rotateBackups(const QString &fileName, int backups, const QString &newBackup)
+{
+	QFile::remove(getBackupName(fileName, backups));
+	for (int i = backups - 1; i >= 1; --i)
+		QFile::rename(getBackupName(fileName, i), getBackupName(fileName, i + 1));
+	QFile::rename(newBackup, getBackupName(fileName, 1));
+}
+
+/* static member */
+QString FileWriter::getBackupName(const QString &fileName, int number)
+{
+	if (number == 1)
+		return fileName + '~';
+	return fileName + '~' + QString::number(number);
+}
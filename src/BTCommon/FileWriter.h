@@ -0,0 +1,59 @@
+#ifndef FILE_WRITER_H
+#define FILE_WRITER_H
+
+#include <QtCore>
+
+/**
+ * \class FileWriter
+ * Writes already serialized data to disk on its own thread, so saving does not block the GUI.
+ * Every file is written once, to a temporary file that is synced and atomically renamed over the target
+ * (QSaveFile), so a crash never leaves a partially written file behind.
+ * Previous versions of the file are kept as rotating backups (name~, name~2, ...); the target itself is never
+ * moved away, so it always holds a complete version.
+ * Writes are performed in the order they were requested.
+ */
+class FileWriter : public QThread
+{
+Q_OBJECT;
+
+public:
+	static const int DEFAULT_BACKUPS = 1;					/**< Number of previous versions kept by default. */
+
+	static FileWriter & getInstance();
+
+	static void write(const QString &fileName, const QByteArray &data, int backups = DEFAULT_BACKUPS);
+	static void waitForFinished();
+
+signals:
+	void written(const QString &fileName, bool success);
+
+protected:
+	void run();
+
+private:
+	struct Job {
+		QString fileName;
+		QByteArray data;
+		int backups;
+	};
+
+	FileWriter(QObject *parent = nullptr);
+	~FileWriter();
+	FileWriter(const FileWriter &) = delete;
+	void operator = (const FileWriter &) = delete;
+
+	QMutex mutex;
+	QWaitCondition jobAdded;
+	QWaitCondition jobsFinished;
+	QQueue <Job> jobs;
+	bool busy;								/**< A job was taken from the queue and is being written. */
+	bool quitting;
+
+	static constexpr const char *BACKUP_TEMPORARY_SUFFIX = ".new";		/**< Copy of the previous version, waiting for the commit. */
+
+	static bool writeFile(const Job &job);
+	static void rotateBackups(const QString &fileName, int backups, const QString &newBackup);
+	static QString getBackupName(const QString &fileName, int number);
+};
+
+#endif // FILE_WRITER_H
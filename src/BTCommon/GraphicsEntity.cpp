@@ -1,4 +1,6 @@
+#include "BTCommon/AnimationClock.h"
 #include "BTCommon/GraphicsEntity.h"
+#include <cmath>
 
 /**
  * \class GraphicsEntity
@@ -16,12 +18,16 @@ void GraphicsEntity::setPathFinder(PathFinder *pathFinder)
 GraphicsEntity::GraphicsEntity(Entity *entity)
 {
 	setEntity(entity);
-	timer = new QTimer(this);
-	connect(timer, &QTimer::timeout, this, &GraphicsEntity::advance);
 	setRotationSpeed(DEFAULT_ROTATION_SPEED);
 	setStraightSpeed(DEFAULT_STRAIGHT_SPEED);
 }
 
+/* destructor */
+GraphicsEntity::~GraphicsEntity()
+{
+	AnimationClock::remove(this);
+}
+
 void GraphicsEntity::setEntity(Entity *entity)
 {
 	setParent(entity);
@@ -71,7 +77,7 @@ void GraphicsEntity::init()
 	if (entity->isMovable()) {
 		Movable *movableEntity = static_cast<Movable *>(entity);
 		setPos(pathFinder->getPosition(movableEntity->getDestinationPositionNumber()));
-		destPoint = pos().toPoint();
+		destPoint = pos();
 	}
 	update();
 }
@@ -80,38 +86,33 @@ void GraphicsEntity::paint(QPainter *painter, const QStyleOptionGraphicsItem *op
 {
 	if (!isInMove())
 		staticAdvance();
-	paintEntity(painter);
+	if (option->levelOfDetailFromTransform(painter->worldTransform()) < DETAIL_MIN_LOD)
+		paintSimplifiedEntity(painter);
+	else
+		paintEntity(painter);
 }
 
-QPoint GraphicsEntity::nextPoint(const QPoint &src, const QPoint &dest) const
+/**
+ * Returns the point reached after moving from src towards dest by step.
+ */
+QPointF GraphicsEntity::nextPoint(const QPointF &src, const QPointF &dest, qreal step) const
 {
-	qreal x = dest.x() - src.x();
-	qreal y = dest.y() - src.y();
-
-	if (qAbs(x) <= straightSpeed && qAbs(y) <= straightSpeed)
+	QLineF line(src, dest);
+	if (line.length() <= step)
 		return dest;
-
-	qreal arctan = qAtan2(x, y);
-
-	return QPoint(qSin(arctan) * straightSpeed, qCos(arctan) * straightSpeed) + src;
+	line.setLength(step);
+	return line.p2();
 }
 
-int GraphicsEntity::nextRotation(int src, int dest) const
+/**
+ * Returns the angle reached after turning from src towards dest by step, along the shorter way.
+ */
+qreal GraphicsEntity::nextRotation(qreal src, qreal dest, qreal step) const
 {
-	int s = (src  + BTech::Math::FULL_ANGLE) % BTech::Math::FULL_ANGLE;
-	int d = (dest + BTech::Math::FULL_ANGLE) % BTech::Math::FULL_ANGLE;
-
-	int distance = s - d;
-	int difference = qMin(( distance + BTech::Math::FULL_ANGLE) % BTech::Math::FULL_ANGLE,
-			      (-distance + BTech::Math::FULL_ANGLE) % BTech::Math::FULL_ANGLE);
-
-	if (difference <= rotationSpeed)
-		return d;
-
-	if ((s > d) == (qAbs(distance) > BTech::Math::STRAIGHT_ANGLE))
-		return s + rotationSpeed;
-	else
-		return s - rotationSpeed;
+	qreal difference = std::remainder(dest - src, BTech::Math::FULL_ANGLE);
+	if (qAbs(difference) <= step)
+		return dest;
+	return src + (difference > 0 ? step : -step);
 }
 
 bool GraphicsEntity::isInMove() const
@@ -131,10 +132,13 @@ void GraphicsEntity::countMidPoints()
 void GraphicsEntity::startMovement()
 {
 	countMidPoints();
-	timer->start(TIMER_INTERVAL);
+	AnimationClock::add(this);
 }
 
-void GraphicsEntity::advance()
+/**
+ * Advances the movement by msecs milliseconds. Called by the AnimationClock every frame.
+ */
+void GraphicsEntity::animate(int msecs)
 {
 	Q_ASSERT(entity->isRotable());
 
@@ -143,19 +147,16 @@ void GraphicsEntity::advance()
 	Rotable *rotableEntity = static_cast<Rotable *>(entity);
 
 	if (!rotableEntity->isInMove()) {
-		timer->stop();
+		AnimationClock::remove(this);
 		emit movementEnded();
 		return;
 	}
 
 	if (rotation() != destRotation)
-		setRotation(nextRotation(rotation(), destRotation));
+		setRotation(nextRotation(rotation(), destRotation, rotationSpeed * msecs / 1000.0));
 
-	if (pos() != destPoint) {
-		QPoint curPoint = pos().toPoint();
-		curPoint = nextPoint(curPoint, destPoint);
-		setPos(curPoint);
-	}
+	if (pos() != destPoint)
+		setPos(nextPoint(pos(), destPoint, straightSpeed * msecs / 1000.0));
 
 	if (rotation() == destRotation && pos() == destPoint) {
 		if (!path.empty()) {
@@ -234,6 +235,18 @@ void GraphicsMech::paintEntity(QPainter *painter)
 	painter->restore();
 }
 
+/**
+ * Zoomed out, the mech is drawn as a dot, without the torso and direction marks.
+ */
+void GraphicsMech::paintSimplifiedEntity(QPainter *painter)
+{
+	int size = 20;
+
+	painter->setPen(Qt::NoPen);
+	painter->setBrush(Qt::lightGray);
+	painter->drawEllipse(QPoint(0, 0), size, size);
+}
+
 void GraphicsMech::staticAdvance()
 {}
 
@@ -11,6 +11,7 @@
  * It provides Entity with all display functions and QGraphicsScene coordinates' control and maintenance.
  * What is displayed is entirely dependent on entity's functions and state.
  * To make this class properly, PathFinder must be set with static function setPathFinder.
+ * Movement is driven by the shared AnimationClock and interpolated by elapsed time, not by the number of frames.
  */
 class GraphicsEntity : public QGraphicsObject
 {
@@ -20,6 +21,7 @@ public:
 	static void setPathFinder(PathFinder *pathFinder);
 
 	GraphicsEntity(Entity *entity = nullptr);
+	~GraphicsEntity();
 
 	void setEntity(Entity *entity);
 	void setStraightSpeed(int speed);
@@ -27,6 +29,8 @@ public:
 	void setRotationSpeed(int angleSpeed);
 	int getRotationSpeed() const;
 
+	void animate(int msecs);
+
 public slots:
 	void init();
 
@@ -36,6 +40,9 @@ signals:
 
 protected:
 	virtual void paintEntity(QPainter *painter) = 0;
+	virtual void paintSimplifiedEntity(QPainter *painter) = 0;	/**< Paints the entity when zoomed out. */
+
+	static constexpr qreal DETAIL_MIN_LOD = 0.25;				/**< Below this level of detail entities are simplified. */
 	virtual void staticAdvance() = 0;
 	virtual void dynamicAdvance() = 0;
 
@@ -46,8 +53,8 @@ private:
 
 	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
 
-	QPoint nextPoint(const QPoint &src, const QPoint &dest) const;
-	int nextRotation(int src, int dest) const;
+	QPointF nextPoint(const QPointF &src, const QPointF &dest, qreal step) const;
+	qreal nextRotation(qreal src, qreal dest, qreal step) const;
 
 	bool isInMove() const;
 
@@ -55,22 +62,17 @@ private:
 
 	QList <Position> path;
 
-	QPoint destPoint;
-	int destRotation;
+	QPointF destPoint;
+	qreal destRotation;
 
-	static const int DEFAULT_ROTATION_SPEED = 10;
-	static const int DEFAULT_STRAIGHT_SPEED = 8;
+	static const int DEFAULT_ROTATION_SPEED = 140;				/**< Degrees per second. */
+	static const int DEFAULT_STRAIGHT_SPEED = 115;				/**< Scene units per second. */
 
 	int straightSpeed;
 	int rotationSpeed;
 
-	static const int TIMER_INTERVAL = 70;
-
-	QTimer *timer;
-
 private slots:
 	void startMovement();
-	void advance();
 
 	void adjustCoordinates();
 	void adjustRotation();
@@ -87,6 +89,7 @@ private:
 	virtual QRectF boundingRect() const;
 
 	virtual void paintEntity(QPainter *painter);
+	virtual void paintSimplifiedEntity(QPainter *painter);
 	virtual void staticAdvance();
 	virtual void dynamicAdvance();
 };
@@ -41,15 +41,20 @@ GraphicsHex * GraphicsFactory::get(Hex *hex)
 	return hexToGraphics[hex];
 }
 
+/**
+ * GraphicsHexes are created on first use, so this may create one as well.
+ */
 GraphicsHex * GraphicsFactory::get(const Hex *hex)
 {
-	if (hex == nullptr)
-		qWarning() << "Warning: trying to get graphics hex from null pointer.";
-	if (!hexToGraphics.contains(hex)) {
-		qWarning() << "Warning: Hex not found in the GraphicsFactory";
-		return nullptr;
-	}
-	return hexToGraphics[hex];
+	return get(const_cast<Hex *>(hex));
+}
+
+/**
+ * Unlike get(), never creates a GraphicsHex; returns nullptr if there is none for given Hex.
+ */
+GraphicsHex * GraphicsFactory::find(const Hex *hex)
+{
+	return hexToGraphics.value(hex, nullptr);
 }
 
 void GraphicsFactory::erase(const GraphicsHex *hex)
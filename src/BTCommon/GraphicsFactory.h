@@ -21,6 +21,7 @@ public:
 	static GraphicsEntity * get(const Entity *entity);
 	static GraphicsHex * get(Hex *hex);
 	static GraphicsHex * get(const Hex *hex);
+	static GraphicsHex * find(const Hex *hex);
 	static void erase(const GraphicsHex *hex);
 	static void erase(const GraphicsEntity *entity);
 	static void clear();
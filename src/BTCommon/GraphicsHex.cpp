@@ -2,9 +2,11 @@
 #include "BTCommon/GraphicsFactory.h"
 
 #include "BTCommon/GraphicsHex.h"
+#include "BTCommon/HexUpdateTracker.h"
 
 bool GraphicsHex::gridVisible = false;
 bool GraphicsHex::coordinatesVisible = false;
+HexUpdateTracker *GraphicsHex::updateTracker = nullptr;
 
 // TODO yeah, the potato aspect of hexness
 const QPoint GraphicsHex::nodes[BTech::NODES_NUMBER] = {
@@ -54,6 +56,123 @@ bool GraphicsHex::areCoordinatesVisible()
 	return coordinatesVisible;
 }
 
+GraphicsHex::Resources::Resources()
+{
+	for (int i = 0; i < BTech::NODES_NUMBER; ++i)
+		polygon << nodes[i];
+	path.addPolygon(polygon);
+	path.closeSubpath();
+
+	for (int i = 0; i < BTech::NODES_NUMBER; ++i) {
+		QPolygon area;
+		area << QPoint(0, 0)
+		     << nodes[(i - 1 + BTech::NODES_NUMBER) % BTech::NODES_NUMBER]
+		     << nodes[i];
+		areaPaths[i].addPolygon(area);
+		areaPaths[i].closeSubpath();
+	}
+
+	coordinatesRect = QRect(-getSize() / 2, getSize() / 4, getSize(), getSize() / 2);
+
+	const QPair <QColor, int> borders[toUnderlying(Border::Number)] = {
+		{ Color::Grid,            3 },
+		{ Color::Clicked,         3 },
+		{ Color::UnderMouse,      3 },
+		{ Color::HasAttackObject, 2 },
+		{ Color::UnitMoved,       2 },
+		{ Color::UnitNotMoved,    2 },
+		{ Color::UnitActive,      3 },
+	};
+	for (int i = 0; i < toUnderlying(Border::Number); ++i) {
+		borderPens[i] = QPen(borders[i].first, borders[i].second);
+		cosmeticBorderPens[i] = QPen(borders[i].first, 0);
+	}
+	coordinatesBackgroundPen = QPen(Color::CoordinatesBackground);
+	coordinatesTextPen = QPen(Color::CoordinatesText);
+
+	for (BTech::Terrain terrain : BTech::terrainTypes)
+		terrainBrushes[toUnderlying(terrain)] = QBrush(BTech::terrainColorMap[terrain]);
+	coordinatesBackgroundBrush = QBrush(Color::CoordinatesBackground);
+	moveObjectActionIdleBrush = QBrush(Color::MoveObjectActionIdle);
+	moveObjectActionNotIdleBrush = QBrush(Color::MoveObjectActionNotIdle);
+}
+
+/* static member */
+const GraphicsHex::Resources & GraphicsHex::getResources()
+{
+	static const Resources resources;
+	return resources;
+}
+
+/* static member */
+qreal GraphicsHex::levelOfDetail(const QPainter *painter)
+{
+	return QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+}
+
+/**
+ * Returns the position of the Hex in given row and column of the map, in the scene coordinates.
+ * Columns are 3/2 * size apart; even columns are shifted down by size.
+ */
+/* static member */
+QPoint GraphicsHex::getCenter(int row, int column)
+{
+	return QPoint(getSize() + column * getSize() * 3 / 2,
+	              getSize() + (row * 2 + (column % 2 == 0)) * getSize());
+}
+
+/**
+ * Returns the position of given node of the Hex in given row and column, in the scene coordinates.
+ */
+/* static member */
+QPoint GraphicsHex::getAbsNode(int row, int column, int nodeNumber)
+{
+	return getCenter(row, column) + nodes[(nodeNumber + BTech::NODES_NUMBER) % BTech::NODES_NUMBER];
+}
+
+/**
+ * Returns the bounding rect shared by all Hexes, relative to the center of a Hex.
+ */
+/* static member */
+QRectF GraphicsHex::getBoundingRect()
+{
+	return QRectF(-getSize(),     -getSize(),
+	               getSize() * 2,  getSize() * 2);
+}
+
+/* static member */
+QPen GraphicsHex::getWalkRangePen()
+{
+	return QPen(Color::HasMoveObject, WALK_RANGE_PEN_WIDTH, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+}
+
+/* static member */
+void GraphicsHex::setUpdateTracker(HexUpdateTracker *tracker)
+{
+	updateTracker = tracker;
+}
+
+/**
+ * Returns the area (triangle between the center and one of the edges, numbered as Directions)
+ * containing given point relative to the center, or -1 if the point is too close to the center to tell.
+ */
+/* static member */
+int GraphicsHex::getArea(const QPointF &point)
+{
+	qreal x = point.x();
+	qreal y = point.y();
+	if (qAbs(y) < 2)
+		return -1;
+	BTech::Matrix auxCur, auxPrev;
+	int i = 0;
+	do {
+		++i;
+		auxPrev = auxCur;
+		auxCur = BTech::Matrix(x, y, nodes[i % BTech::NODES_NUMBER].x(), nodes[i % BTech::NODES_NUMBER].y());
+	} while (i < 2 || auxPrev.det() < 0 || auxCur.det() >= 0);
+	return i % BTech::NODES_NUMBER;
+}
+
 /* static member */
 void GraphicsHex::setSize(int newSize)
 {
@@ -67,23 +186,37 @@ int GraphicsHex::getSize()
 }
 
 GraphicsHex::GraphicsHex(Hex *hex)
-	: hex(hex)
+	: baseGridGraphicsObject(nullptr), propertyGridGraphicsObject(nullptr),
+	  mouseClickDependentGridGraphicsObject(nullptr), mouseMoveDependentGridGraphicsObject(nullptr),
+	  hex(hex)
 {
 	setParent(hex);
+	setPos(getCenter(hex->getPoint().y() - 1, hex->getPoint().x() - 1));
 	init();
 	setEnabled(true);
-	setAcceptHoverEvents(true);
-	addGridGraphicsObjects();
 }
 
 GraphicsHex::~GraphicsHex()
 {
-	qDeleteAll(getGridGraphicsObjects());
+	delete baseGridGraphicsObject;
+	delete propertyGridGraphicsObject;
+	delete mouseClickDependentGridGraphicsObject;
+	delete mouseMoveDependentGridGraphicsObject;
 	GraphicsFactory::erase(this);
 }
 
+const Hex * GraphicsHex::getHex() const
+{
+	return hex;
+}
+
+/**
+ * Grid layers are separate items only when Hexes are not drawn by HexLayers, so they are created on first call.
+ */
 QList <GridGraphicsObject *> GraphicsHex::getGridGraphicsObjects()
 {
+	if (baseGridGraphicsObject == nullptr)
+		addGridGraphicsObjects();
 	return { baseGridGraphicsObject,
 	         propertyGridGraphicsObject,
 	         mouseClickDependentGridGraphicsObject,
@@ -102,19 +235,23 @@ QPoint GraphicsHex::getAbsNode(int nodeNumber) const
 
 void GraphicsHex::setClicked(bool clicked)
 {
-	this->clicked = clicked;
-	QGraphicsItem::update();
+	if (Hex::getOverlays() == nullptr || isClicked() == clicked)
+		return;
+	Hex::getOverlays()->setClicked(hex->getNumber(), clicked);
+	updateHex();
 }
 
 bool GraphicsHex::isClicked() const
 {
-	return clicked;
+	return Hex::getOverlays() != nullptr && Hex::getOverlays()->isClicked(hex->getNumber());
 }
 
 void GraphicsHex::setTracked(bool tracked)
 {
 	this->tracked = tracked;
-	update();
+	if (!tracked)
+		trackedArea = -1;
+	updateHex();
 }
 
 bool GraphicsHex::isTracked() const
@@ -122,6 +259,13 @@ bool GraphicsHex::isTracked() const
 	return tracked;
 }
 
+void GraphicsHex::setTrackedArea(int area)
+{
+	trackedArea = area;
+	hex->setMoveObject(area);
+	updateHex();
+}
+
 int GraphicsHex::getTrackedArea() const
 {
 	return trackedArea;
@@ -138,7 +282,7 @@ void GraphicsHex::clear()
 	hex->clear();
 	setClicked(false);
 	setTracked(false);
-	QGraphicsItem::update();
+	updateHex();
 }
 
 void GraphicsHex::addGridGraphicsObjects()
@@ -164,152 +308,140 @@ void GraphicsHex::addGridGraphicsObjects()
 // TODO that bounding rect problem
 QRectF GraphicsHex::boundingRect() const
 {
-	return QRectF(-getSize(),     -getSize(),
-	               getSize() * 2,  getSize() * 2);
+	return getBoundingRect();
 }
 
 QPainterPath GraphicsHex::shape() const
 {
-	QPainterPath path;
-	QPolygon polygon;
-	for (int i = 0; i < BTech::NODES_NUMBER; ++i)
-		polygon << getNode(i);
-	path.addPolygon(polygon);
-	return path;
+	return getResources().path;
 }
 
 void GraphicsHex::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
 {
+	paintTerrain(painter, hex, this);
+}
+
+/* static member */
+void GraphicsHex::paintTerrain(QPainter *painter, const Hex *hex, const GraphicsHex *graphicsHex)
+{
+	const Resources &resources = getResources();
+
 	// TODO replace with an image
-	painter->setBrush(BTech::terrainColorMap[hex->getTerrain()]);
+	painter->setBrush(resources.terrainBrushes[toUnderlying(hex->getTerrain())]);
 	painter->setPen(Qt::NoPen);
-	painter->drawPath(shape());
-
-	if (areCoordinatesVisible()) {
-		painter->setBrush(Color::CoordinatesBackground);
-		painter->setPen(Color::CoordinatesBackground);
-		painter->drawRect(QRect(-getSize() / 2, getSize() / 4, getSize(), getSize() / 2));
-		painter->setPen(Color::CoordinatesText);
-		painter->drawText(-getSize() / 2, getSize() / 4, getSize(), getSize() / 2, Qt::AlignCenter,
-			QString("%1, %2").arg(hex->getPoint().x()).arg(hex->getPoint().y()));
+	painter->drawPath(resources.path);
+
+	if (areCoordinatesVisible() && levelOfDetail(painter) >= COORDINATES_MIN_LOD) {
+		QString text = (graphicsHex != nullptr) ? graphicsHex->coordinatesText : QString();
+		if (text.isNull()) {
+			text = QString("%1, %2").arg(hex->getPoint().x()).arg(hex->getPoint().y());
+			if (graphicsHex != nullptr)
+				graphicsHex->coordinatesText = text;
+		}
+		painter->setBrush(resources.coordinatesBackgroundBrush);
+		painter->setPen(resources.coordinatesBackgroundPen);
+		painter->drawRect(resources.coordinatesRect);
+		painter->setPen(resources.coordinatesTextPen);
+		painter->drawText(resources.coordinatesRect, Qt::AlignCenter, text);
 	}
 }
 
-void GraphicsHex::paintBaseGrid(QPainter *painter)
+/* static member */
+void GraphicsHex::paintBaseGrid(QPainter *painter, const Hex *, const GraphicsHex *)
 {
-	if (isGridVisible())
-		paintBorder(painter, 3, Color::Grid);
+	if (isGridVisible() && levelOfDetail(painter) >= DETAIL_MIN_LOD)
+		paintBorder(painter, Border::Grid);
 }
 
-void GraphicsHex::paintPropertyGrid(QPainter *painter)
+/* static member */
+void GraphicsHex::paintPropertyGrid(QPainter *painter, const Hex *hex, const GraphicsHex *)
 {
-	if (hex->hasMoveObject())
-		paintBorder(painter, 2, Color::HasMoveObject);
 	if (hex->isAttackable())
-		paintBorder(painter, 2, Color::HasAttackObject);
+		paintBorder(painter, Border::HasAttackObject);
 	if (hex->getMech() != nullptr) {
 		if (hex->getMech()->isFriendly()) {
 			if (hex->getMech()->isMoved())
-				paintBorder(painter, 2, Color::UnitMoved);
+				paintBorder(painter, Border::UnitMoved);
 			else
-				paintBorder(painter, 2, Color::UnitNotMoved);
+				paintBorder(painter, Border::UnitNotMoved);
 		}
 
 		if (hex->getMech()->isActive())
-			paintBorder(painter, 3, Color::UnitActive);
+			paintBorder(painter, Border::UnitActive);
 	}
 }
 
-void GraphicsHex::paintMouseClickDependentGrid(QPainter *painter)
+/* static member */
+void GraphicsHex::paintMouseClickDependentGrid(QPainter *painter, const Hex *hex, const GraphicsHex *)
 {
-	if (isClicked())
-		paintBorder(painter, 3, Color::Clicked);
+	if (Hex::getOverlays() != nullptr && Hex::getOverlays()->isClicked(hex->getNumber()))
+		paintBorder(painter, Border::Clicked);
 }
 
-void GraphicsHex::paintMouseMoveDependentGrid(QPainter *painter)
+/**
+ * Only the tracked Hex paints anything, and it always has a GraphicsHex holding the tracking state.
+ */
+/* static member */
+void GraphicsHex::paintMouseMoveDependentGrid(QPainter *painter, const Hex *hex, const GraphicsHex *graphicsHex)
 {
-	if (isTracked()) {
-		paintBorder(painter, 3, Color::UnderMouse);
-		if (hex->hasMoveObject()) {
-			QPolygon polygon;
-			polygon << QPoint(0, 0) << getNode(trackedArea - 1) << getNode(trackedArea);
-			QPainterPath path;
-			path.addPolygon(polygon);
+	if (graphicsHex != nullptr && graphicsHex->isTracked()) {
+		const int trackedArea = graphicsHex->getTrackedArea();
+		paintBorder(painter, Border::UnderMouse);
+		if (hex->hasMoveObject() && trackedArea != -1 && levelOfDetail(painter) >= DETAIL_MIN_LOD) {
+			const Resources &resources = getResources();
 			painter->setPen(Qt::NoPen);
 			if (hex->getMoveObject().getAction() == BTech::MovementAction::Idle)
-				painter->setBrush(Color::MoveObjectActionIdle);
+				painter->setBrush(resources.moveObjectActionIdleBrush);
 			else
-				painter->setBrush(Color::MoveObjectActionNotIdle);
-			painter->drawPath(path);
+				painter->setBrush(resources.moveObjectActionNotIdleBrush);
+			painter->drawPath(resources.areaPaths[trackedArea]);
 		}
 	}
 }
 
-void GraphicsHex::paintBorder(QPainter *painter, int width, const QColor &color)
-{
-	QPen pen;
-	pen.setWidth(width);
-	pen.setColor(color);
-	painter->setPen(pen);
-
-	QPoint node1;
-	QPoint node2;
-	for (int i = 0; i < BTech::NODES_NUMBER; ++i) {
-		node1 = getNode(i);
-		node2 = getNode(i + 1);
-		painter->drawLine(node1.x(), node1.y(), node2.x(), node2.y());
-	}
-}
-
-void GraphicsHex::mousePressEvent(QGraphicsSceneMouseEvent *event)
-{
-	emit activated(hex->getNumber());
-	event->accept();
-}
-
-void GraphicsHex::hoverEnterEvent(QGraphicsSceneHoverEvent *event)
+/**
+ * Schedules repainting of the Hex and all its grid layers.
+ */
+void GraphicsHex::updateHex()
 {
-	setTracked(true);
-	emit mouseEntered(hex->getNumber());
-	event->accept();
+	if (updateTracker != nullptr)
+		updateTracker->add(hex->getNumber());
+	else
+		QGraphicsItem::update();
 }
 
-void GraphicsHex::hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
+/**
+ * Schedules repainting of given Hex without creating its GraphicsHex.
+ */
+/* static member */
+void GraphicsHex::updateHex(const Hex *hex)
 {
-	setTracked(false);
-	trackedArea = -1;
-	emit mouseLeft(hex->getNumber());
-	event->accept();
+	if (updateTracker != nullptr)
+		updateTracker->add(hex->getNumber());
+	else if (GraphicsHex *graphicsHex = GraphicsFactory::find(hex))
+		graphicsHex->update();
 }
 
-void GraphicsHex::hoverMoveEvent(QGraphicsSceneHoverEvent *event)
+/**
+ * When zoomed out, the border is drawn with a cosmetic pen.
+ */
+/* static member */
+void GraphicsHex::paintBorder(QPainter *painter, Border border)
 {
-	qreal x = event->pos().x();
-	qreal y = event->pos().y();
-	event->accept();
-	if (!hex->hasMoveObject() || qAbs(y) < 2)
-		return;
-	BTech::Matrix auxCur, auxPrev;
-	int i = 0;
-	do {
-		++i;
-		auxPrev = auxCur;
-		auxCur = BTech::Matrix(x, y, getNode(i).x(), getNode(i).y());
-	} while (i < 2 || auxPrev.det() < 0 || auxCur.det() >= 0);
-	int prevHexTracked = trackedArea;
-	trackedArea = i % BTech::NODES_NUMBER;
-	if (trackedArea != prevHexTracked) {
-		hex->setMoveObject(trackedArea);
-		emit newAreaTracked(hex->getNumber());
-	}
-	QGraphicsItem::update();
+	const Resources &resources = getResources();
+	if (levelOfDetail(painter) < DETAIL_MIN_LOD)
+		painter->setPen(resources.cosmeticBorderPens[toUnderlying(border)]);
+	else
+		painter->setPen(resources.borderPens[toUnderlying(border)]);
+	painter->setBrush(Qt::NoBrush);
+	painter->drawPolygon(resources.polygon);
 }
 
 /**
  * \class GridGraphicsObject
  */
 
-GridGraphicsObject::GridGraphicsObject(GraphicsHex *parent, void (GraphicsHex::*paintFunction)(QPainter *painter), int zValue)
+GridGraphicsObject::GridGraphicsObject(GraphicsHex *parent, GraphicsHex::LayerPaintFunction paintFunction, int zValue)
 	: hex(parent), paintFunction(paintFunction)
 {
 	setParent(parent);
@@ -328,5 +460,5 @@ QPainterPath GridGraphicsObject::shape() const
 
 void GridGraphicsObject::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
-	return (hex->*paintFunction)(painter);
+	paintFunction(painter, hex->getHex(), hex);
 }
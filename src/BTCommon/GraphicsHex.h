@@ -6,22 +6,37 @@
 #include "BTCommon/Utils.h"
 
 class GridGraphicsObject;
+class HexUpdateTracker;
 
 class GraphicsHex : public QGraphicsObject
 {
 Q_OBJECT;
 
 public:
+	/**
+	 * Paints one layer of a Hex from its data. graphicsHex is the GraphicsHex of the Hex, or nullptr if none was created,
+	 * so batched layers can paint without creating any items.
+	 */
+	typedef void (*LayerPaintFunction)(QPainter *painter, const Hex *hex, const GraphicsHex *graphicsHex);
+
 	static void setSize(int size);
 	static int getSize();
 	static void setGridVisible(bool visible);
 	static bool isGridVisible();
 	static void setCoordinatesVisible(bool visible);
 	static bool areCoordinatesVisible();
+	static qreal levelOfDetail(const QPainter *painter);
+	static void setUpdateTracker(HexUpdateTracker *tracker);
+	static int getArea(const QPointF &point);
+	static QPoint getCenter(int row, int column);
+	static QRectF getBoundingRect();
+	static QPoint getAbsNode(int row, int column, int nodeNumber);
+	static QPen getWalkRangePen();
 
 	GraphicsHex(Hex *hex);
 	~GraphicsHex();
 
+	const Hex * getHex() const;
 	QList <GridGraphicsObject *> getGridGraphicsObjects();
 	QPoint getNode(int nodeNumber) const;
 	QPoint getAbsNode(int nodeNumber) const;
@@ -30,6 +45,7 @@ public:
 	bool isClicked() const;
 	void setTracked(bool tracked);
 	bool isTracked() const;
+	void setTrackedArea(int area);
 	int getTrackedArea() const;
 
 	void init();
@@ -39,16 +55,19 @@ public:
 	QRectF boundingRect() const;
 	QPainterPath shape() const;
 	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option = nullptr, QWidget *widget = nullptr);
-	void paintBaseGrid(QPainter *painter);
-	void paintPropertyGrid(QPainter *painter);
-	void paintMouseClickDependentGrid(QPainter *painter);
-	void paintMouseMoveDependentGrid(QPainter *painter);
+	static void paintTerrain(QPainter *painter, const Hex *hex, const GraphicsHex *graphicsHex);
+	static void paintBaseGrid(QPainter *painter, const Hex *hex, const GraphicsHex *graphicsHex);
+	static void paintPropertyGrid(QPainter *painter, const Hex *hex, const GraphicsHex *graphicsHex);
+	static void paintMouseClickDependentGrid(QPainter *painter, const Hex *hex, const GraphicsHex *graphicsHex);
+	static void paintMouseMoveDependentGrid(QPainter *painter, const Hex *hex, const GraphicsHex *graphicsHex);
+
+	void updateHex();
+	static void updateHex(const Hex *hex);
 
-signals:
-	void activated(int);
-	void mouseEntered(int);
-	void mouseLeft(int);
-	void newAreaTracked(int);
+	static const int BASE_GRID_GRAPHICS_OBJECT_Z_VALUE                  = 1;
+	static const int PROPERTY_GRID_GRAPHICS_OBJECT_Z_VALUE              = 2;
+	static const int MOUSE_CLICK_DEPENDENT_GRID_GRAPHICS_OBJECT_Z_VALUE = 3;
+	static const int MOUSE_MOVE_DEPENDENT_GRID_GRAPHICS_OBJECT_Z_VALUE  = 4;
 
 private:
 	GridGraphicsObject *baseGridGraphicsObject;
@@ -60,10 +79,9 @@ private:
 	static const int MIN_HEX_SIZE     = 10;
 	static const int MAX_HEX_SIZE     = 100;
 
-	static const int BASE_GRID_GRAPHICS_OBJECT_Z_VALUE                  = 1;
-	static const int PROPERTY_GRID_GRAPHICS_OBJECT_Z_VALUE              = 2;
-	static const int MOUSE_CLICK_DEPENDENT_GRID_GRAPHICS_OBJECT_Z_VALUE = 3;
-	static const int MOUSE_MOVE_DEPENDENT_GRID_GRAPHICS_OBJECT_Z_VALUE  = 4;
+	static constexpr qreal COORDINATES_MIN_LOD = 0.5;			/**< Below this level of detail coordinates are not drawn. */
+	static constexpr qreal DETAIL_MIN_LOD = 0.25;				/**< Below this level of detail Hexes are drawn as flat shapes only. */
+	static const int WALK_RANGE_PEN_WIDTH = 3;				/**< Width of the outline around the walk range. */
 
 	struct Color {
 		static const QColor Grid;
@@ -81,21 +99,56 @@ private:
 		static const QColor CoordinatesText;
 	};
 
+	enum class Border : quint8 {
+		Grid,
+		Clicked,
+		UnderMouse,
+		HasAttackObject,
+		UnitMoved,
+		UnitNotMoved,
+		UnitActive,
+		Number
+	};
+
+	/**
+	 * \class Resources
+	 * Geometry, pens and brushes shared by all GraphicsHexes. Built once, on first use, so painting does not allocate.
+	 */
+	struct Resources {
+		Resources();
+
+		static const int TERRAIN_BRUSHES_NUMBER = 8;			/**< Terrain brushes are indexed by the underlying value of Terrain. */
+
+		QPolygon polygon;
+		QPainterPath path;
+		QPainterPath areaPaths[BTech::NODES_NUMBER];			/**< Triangles between the center and one of the edges. */
+		QRect coordinatesRect;
+
+		QPen borderPens[toUnderlying(Border::Number)];
+		QPen cosmeticBorderPens[toUnderlying(Border::Number)];	/**< Used instead of borderPens when zoomed out. */
+		QPen coordinatesBackgroundPen;
+		QPen coordinatesTextPen;
+
+		QBrush terrainBrushes[TERRAIN_BRUSHES_NUMBER];
+		QBrush coordinatesBackgroundBrush;
+		QBrush moveObjectActionIdleBrush;
+		QBrush moveObjectActionNotIdleBrush;
+	};
+
+	static const Resources & getResources();
+
 	Hex *hex;
 
 	static const QPoint nodes[BTech::NODES_NUMBER];
 
 	static bool gridVisible;
 	static bool coordinatesVisible;
+	static HexUpdateTracker *updateTracker;	/**< Collects changed Hexes, so the scene is updated once per frame. */
 
-	void paintBorder(QPainter *painter, int width, const QColor &color);
+	static void paintBorder(QPainter *painter, Border border);
 
-	void mousePressEvent(QGraphicsSceneMouseEvent *event);
-	void hoverEnterEvent(QGraphicsSceneHoverEvent *event);
-	void hoverLeaveEvent(QGraphicsSceneHoverEvent *event);
-	void hoverMoveEvent(QGraphicsSceneHoverEvent *event);
+	mutable QString coordinatesText;					/**< Built on first use. */
 
-	bool clicked;
 	bool tracked;
 	int trackedArea;
 };
@@ -104,7 +157,7 @@ class GridGraphicsObject : public QGraphicsObject
 {
 
 public:
-	GridGraphicsObject(GraphicsHex *parent, void (GraphicsHex::*)(QPainter *painter), int zValue);
+	GridGraphicsObject(GraphicsHex *parent, GraphicsHex::LayerPaintFunction paintFunction, int zValue);
 
 private:
 	QRectF boundingRect() const;
@@ -112,7 +165,7 @@ private:
 	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option = nullptr, QWidget *widget = nullptr);
 
 	GraphicsHex *hex;
-	void (GraphicsHex::*paintFunction)(QPainter *painter);
+	GraphicsHex::LayerPaintFunction paintFunction;
 };
 
 #endif // GRAPHICS_HEX_H
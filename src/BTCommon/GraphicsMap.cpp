@@ -1,5 +1,6 @@
 #include "BTCommon/EnumHashFunctions.h"
 #include "BTCommon/GraphicsMap.h"
+#include "BTCommon/Settings.h"
 
 const QHash <BTech::GamePhase, void (GraphicsMap::*)()> GraphicsMap::phaseToFunction {
 	{BTech::GamePhase::None,           &GraphicsMap::noPhase},
@@ -14,7 +15,21 @@ const QHash <BTech::GamePhase, void (GraphicsMap::*)()> GraphicsMap::phaseToFunc
 };
 
 GraphicsMap::GraphicsMap()
-{}
+	: batchedRendering(Settings::value("map/batchedRendering", true).toBool()), mapLoader(nullptr), terrainLayer(nullptr), hexUpdateTracker(nullptr), walkRangeItem(nullptr), trackedHex(-1),
+	  scale(1), finalScale(1), startScale(1), scaleEasing(QEasingCurve::OutCubic)
+{
+	scaleTimer = new QTimer(this);
+	scaleTimer->setInterval(SCALE_ANIM_INTERVAL);
+	connect(scaleTimer, &QTimer::timeout, this, &GraphicsMap::scaleView);
+}
+
+GraphicsMap::~GraphicsMap()
+{
+	if (mapLoader != nullptr)
+		mapLoader->wait();
+	if (mapLoaded)
+		saveCache();
+}
 
 void GraphicsMap::createNewMap(int width, int height)
 {
@@ -26,22 +41,28 @@ void GraphicsMap::createNewMap(int width, int height)
 	emit mapHasBeenLoaded();
 }
 
+/**
+ * Starts reading the map file on a worker thread; mapHasBeenLoaded() or mapLoadFailed() is emitted when done.
+ * The current map stays displayed until the new one is read, and is kept if the file cannot be read.
+ * Returns false if no file is given or another map is being loaded.
+ */
 bool GraphicsMap::loadMap(const QString &mapFileName)
 {
-	if (mapLoaded)
-		clearMap();
-	if (!Map::loadMap(mapFileName))
+	if (mapFileName.isEmpty() || mapLoader != nullptr)
 		return false;
-	initMap();
-	mapLoaded = true;
-	emit mapHasBeenLoaded();
+	mapLoader = new MapLoader(mapFileName, this);
+	connect(mapLoader, &QThread::finished, this, &GraphicsMap::mapFileRead);
+	emit mapLoadStarted();
+	mapLoader->start();
 	return true;
 }
 
 void GraphicsMap::toggleGrid()
 {
 	grid->toggleGrid();
-	scene()->update();
+	if (terrainLayer != nullptr)
+		terrainLayer->invalidate();
+	hexUpdateTracker->addAll();
 }
 
 bool GraphicsMap::isGridVisible() const
@@ -52,7 +73,9 @@ bool GraphicsMap::isGridVisible() const
 void GraphicsMap::toggleCoordinates()
 {
 	grid->toggleCoordinates();
-	scene()->update();
+	if (terrainLayer != nullptr)
+		terrainLayer->invalidate();
+	hexUpdateTracker->addAll();
 }
 
 bool GraphicsMap::areCoordinatesVisible() const
@@ -60,6 +83,17 @@ bool GraphicsMap::areCoordinatesVisible() const
 	return grid->areCoordinatesVisible();
 }
 
+/**
+ * Has to be called after Hex's terrain (or anything else painted with it) has been changed.
+ */
+void GraphicsMap::updateHexTerrain(const Hex *hex)
+{
+	if (terrainLayer != nullptr)
+		terrainLayer->invalidate(hex->getNumber());
+	else
+		GraphicsFactory::get(hex)->update();
+}
+
 void GraphicsMap::addMechToHex(MechEntity *mech, Hex *hex, Player *player)
 {
 	if (hex->getMech() != nullptr) {
@@ -80,11 +114,6 @@ QPair <QString, QColor> GraphicsMap::getMessage() const
 	return {message, messageColor};
 }
 
-QPair <QString, QColor> GraphicsMap::getExtInfo() const
-{
-	return {extensiveInfo, extensiveInfoColor};
-}
-
 void GraphicsMap::incScale(int times)
 {
 	qreal newScale = finalScale;
@@ -108,6 +137,7 @@ void GraphicsMap::onChooseAction(const Action *action)
 	grid->hideWalkRange();
 	grid->hideShootRange();
 	chooseAction(action);
+	updateWalkRange();
 }
 
 void GraphicsMap::onEndMove()
@@ -139,10 +169,27 @@ void GraphicsMap::initScene()
 
 void GraphicsMap::initGrid()
 {
-	grid = new Grid(hexes, hexWidth, hexHeight);
+	grid = new Grid(hexes, hexWidth, hexHeight, &cache);
 }
 
 void GraphicsMap::initHexes()
+{
+	hexUpdateTracker = new HexUpdateTracker(scene(), hexes, this);
+	GraphicsHex::setUpdateTracker(hexUpdateTracker);
+
+	if (batchedRendering)
+		initHexLayers();
+	else
+		initHexItems();
+
+	walkRangeItem = new QGraphicsPathItem;
+	walkRangeItem->setPen(GraphicsHex::getWalkRangePen());
+	walkRangeItem->setBrush(Qt::NoBrush);
+	walkRangeItem->setZValue(GraphicsHex::PROPERTY_GRID_GRAPHICS_OBJECT_Z_VALUE);
+	scene()->addItem(walkRangeItem);
+}
+
+void GraphicsMap::initHexItems()
 {
 	for (Hex *hex : hexes) {
 		GraphicsHex *graphicsHex = GraphicsFactory::get(hex);
@@ -151,14 +198,27 @@ void GraphicsMap::initHexes()
 			scene()->addItem(object);
 			object->setPos(graphicsHex->pos());
 		}
-
-		connect(graphicsHex, &GraphicsHex::activated,      this, static_cast<void (GraphicsMap::*)(int)>(&GraphicsMap::hexClicked));
-		connect(graphicsHex, &GraphicsHex::mouseEntered,   this, &GraphicsMap::hexTracked);
-		connect(graphicsHex, &GraphicsHex::mouseLeft,      this, &GraphicsMap::hexAbandoned);
-		connect(graphicsHex, &GraphicsHex::newAreaTracked, this, &GraphicsMap::hexNewAreaTracked);
 	}
 }
 
+void GraphicsMap::initHexLayers()
+{
+	terrainLayer = new HexLayer(hexes, hexWidth, hexHeight, &GraphicsHex::paintTerrain, 0);
+	terrainLayer->setTileCacheEnabled(true);
+
+	hexLayers << terrainLayer
+	          << new HexLayer(hexes, hexWidth, hexHeight, &GraphicsHex::paintBaseGrid,
+	                          GraphicsHex::BASE_GRID_GRAPHICS_OBJECT_Z_VALUE)
+	          << new HexLayer(hexes, hexWidth, hexHeight, &GraphicsHex::paintPropertyGrid,
+	                          GraphicsHex::PROPERTY_GRID_GRAPHICS_OBJECT_Z_VALUE)
+	          << new HexLayer(hexes, hexWidth, hexHeight, &GraphicsHex::paintMouseClickDependentGrid,
+	                          GraphicsHex::MOUSE_CLICK_DEPENDENT_GRID_GRAPHICS_OBJECT_Z_VALUE)
+	          << new HexLayer(hexes, hexWidth, hexHeight, &GraphicsHex::paintMouseMoveDependentGrid,
+	                          GraphicsHex::MOUSE_MOVE_DEPENDENT_GRID_GRAPHICS_OBJECT_Z_VALUE);
+	for (HexLayer *layer : hexLayers)
+		scene()->addItem(layer);
+}
+
 void GraphicsMap::initUnits()
 {
 	for (Player *player : players)
@@ -174,14 +234,16 @@ void GraphicsMap::initUnit(MechEntity *mech)
 
 	connect(mech, &MechEntity::stateInfoSent, this, &GraphicsMap::mechStateInfoReceived);
 	connect(mech, &MechEntity::infoSent, this, &GraphicsMap::mechInfoReceived);
-	connect(mech, &MechEntity::extensiveInfoSent, this, &GraphicsMap::mechExtensiveInfoReceived);
+	connect(mech, &MechEntity::combatEventSent, this, &GraphicsMap::mechCombatEventReceived);
 
 	emit mechAdded(mech);
 }
 
 void GraphicsMap::initScaling()
 {
-	scale = 1;
+	scale = transform().m11();
+	if (!scaleTimer->isActive())
+		finalScale = scale;
 	scaleSpeed = DEFAULT_SCALE_SPEED;
 
 	qreal mDim = (qreal)(qMax(hexWidth, hexHeight));
@@ -196,20 +258,20 @@ void GraphicsMap::initWindowSettings()
 	setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 	setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 	setMouseTracking(true);
+	setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
 	setEnabled(true);
 }
 
+/**
+ * The animation is not restarted from scratch; it continues from the current zoom level towards the new target.
+ */
 void GraphicsMap::changeScale(qreal scale)
 {
+	startScale = this->scale;
 	finalScale = scale;
-
-	//TODO CFiend wymienić na to? http://qt-project.org/doc/qt-5.1/qtcore/qpropertyanimation.html
-	//TODO Fynx: Dunno. In your hands.
-	QTimeLine *scaleAnim = new QTimeLine(SCALE_ANIM_TIME, this);
-	scaleAnim->setUpdateInterval(SCALE_ANIM_INTERVAL);
-	connect(scaleAnim, &QTimeLine::valueChanged, this, &GraphicsMap::scaleView);
-	connect(scaleAnim, &QTimeLine::finished, this, &GraphicsMap::scaleAnimFinished);
-	scaleAnim->start();
+	scaleAnimTime.start();
+	if (!scaleTimer->isActive())
+		scaleTimer->start();
 }
 
 void GraphicsMap::mouseMoveEvent(QMouseEvent *event)
@@ -223,6 +285,8 @@ void GraphicsMap::mouseMoveEvent(QMouseEvent *event)
 	}
 
 	QGraphicsView::mouseMoveEvent(event);
+	if (mapLoaded)
+		trackHex(mapToScene(event->pos()));
 }
 
 void GraphicsMap::mousePressEvent(QMouseEvent *event)
@@ -232,6 +296,12 @@ void GraphicsMap::mousePressEvent(QMouseEvent *event)
 		mousePosition = event->pos();
 	}
 	QGraphicsView::mousePressEvent(event);
+
+	if (mapLoaded) {
+		int number = grid->getHexNumber(mapToScene(event->pos()));
+		if (number != -1)
+			hexClicked(number);
+	}
 }
 
 void GraphicsMap::mouseReleaseEvent(QMouseEvent *event)
@@ -242,6 +312,13 @@ void GraphicsMap::mouseReleaseEvent(QMouseEvent *event)
 	QGraphicsView::mouseReleaseEvent(event);
 }
 
+void GraphicsMap::leaveEvent(QEvent *event)
+{
+	if (mapLoaded)
+		trackHex(QPointF(-SCENE_BORDER, -SCENE_BORDER));
+	QGraphicsView::leaveEvent(event);
+}
+
 void GraphicsMap::wheelEvent(QWheelEvent *event)
 {
 	int numDegrees = event->delta() / 8;
@@ -262,6 +339,7 @@ void GraphicsMap::noPhase()
 {
 	grid->hideWalkRange();
 	grid->hideShootRange();
+	updateWalkRange();
 }
 
 void GraphicsMap::emitGameStarted()
@@ -297,20 +375,19 @@ void GraphicsMap::emitMechActionsNotNeeded()
 void GraphicsMap::emitMechWalkRangeNeeded(const MovementObject &movement)
 {
 	grid->showWalkRange(movement);
-	scene()->update();
+	updateWalkRange();
 }
 
 void GraphicsMap::emitMechShootRangeNeeded(const MechEntity *mech)
 {
 	grid->showShootRange(mech);
-	scene()->update();
 }
 
 void GraphicsMap::emitMechRangesNotNeeded()
 {
 	grid->hideWalkRange();
 	grid->hideShootRange();
-	scene()->update();
+	updateWalkRange();
 }
 
 void GraphicsMap::emitPlayerTurn(const Player *player)
@@ -322,12 +399,24 @@ void GraphicsMap::emitPlayerTurn(const Player *player)
 void GraphicsMap::emitHexesNeedClearing()
 {
 	grid->hideAll();
-	scene()->update();
+	updateWalkRange();
 }
 
+/**
+ * Unit state (friendly, moved, active) is drawn on the Hexes, so both the Hexes occupied by units now
+ * and the ones they occupied at the previous update are repainted.
+ */
 void GraphicsMap::emitHexesNeedUpdating()
 {
-	scene()->update();
+	for (int number : unitHexes)
+		hexUpdateTracker->add(number);
+	unitHexes.clear();
+	for (Player *player : players) {
+		for (MechEntity *mech : player->getMechs()) {
+			unitHexes << mech->getCurrentPositionNumber();
+			hexUpdateTracker->add(mech->getCurrentPositionNumber());
+		}
+	}
 }
 
 void GraphicsMap::emitMessageSent(const QString &message, const QColor &color)
@@ -337,15 +426,18 @@ void GraphicsMap::emitMessageSent(const QString &message, const QColor &color)
 	emit messageSent();
 }
 
-void GraphicsMap::emitExtensiveInfoSent(const QString &info, const QColor &color)
-{
-	this->extensiveInfo = info;
-	this->extensiveInfoColor = color;
-	emit extensiveInfoSent();
-}
-
 void GraphicsMap::clearMap()
 {
+	qDeleteAll(hexLayers);
+	hexLayers.clear();
+	terrainLayer = nullptr;
+	delete walkRangeItem;
+	walkRangeItem = nullptr;
+	GraphicsHex::setUpdateTracker(nullptr);
+	delete hexUpdateTracker;
+	hexUpdateTracker = nullptr;
+	unitHexes.clear();
+	trackedHex = -1;
 	Map::clearMap();
 	delete grid;
 	mapLoaded = false;
@@ -353,6 +445,41 @@ void GraphicsMap::clearMap()
 	emit mapCleared();
 }
 
+/**
+ * Finds the Hex (and its area) under given point of the scene and emits the signals for the Hex
+ * that stopped and the one that started being tracked.
+ */
+void GraphicsMap::trackHex(const QPointF &point)
+{
+	int number = grid->getHexNumber(point);
+	if (number != trackedHex) {
+		if (trackedHex != -1) {
+			GraphicsFactory::get(hexes[trackedHex])->setTracked(false);
+			hexAbandoned(trackedHex);
+		}
+		trackedHex = number;
+		if (trackedHex != -1) {
+			GraphicsFactory::get(hexes[trackedHex])->setTracked(true);
+			hexTracked(trackedHex);
+		}
+	}
+
+	if (trackedHex == -1 || !hexes[trackedHex]->hasMoveObject())
+		return;
+	GraphicsHex *graphicsHex = GraphicsFactory::get(hexes[trackedHex]);
+	int area = GraphicsHex::getArea(point - graphicsHex->pos());
+	if (area != -1 && area != graphicsHex->getTrackedArea()) {
+		graphicsHex->setTrackedArea(area);
+		hexNewAreaTracked(trackedHex);
+	}
+}
+
+void GraphicsMap::updateWalkRange()
+{
+	if (walkRangeItem != nullptr)
+		walkRangeItem->setPath(grid->getWalkRangeOutline());
+}
+
 void GraphicsMap::hexClicked(int hexNumber)
 {
 	emit hexClicked(hexes[hexNumber]);
@@ -382,14 +509,12 @@ void GraphicsMap::mechInfoReceived()
 	                playerNameToColor[mech->getOwnerName()]);
 }
 
-void GraphicsMap::mechExtensiveInfoReceived()
+void GraphicsMap::mechCombatEventReceived(const CombatEvent &event)
 {
-	MechEntity *mech = static_cast<MechEntity *>(sender());
-	if (mech->getInfo().isEmpty())
-		emitExtensiveInfoSent(mech->getType() + " (" + mech->getOwnerName() + ")",
-		                      playerNameToColor[mech->getOwnerName()]); /** signature */
+	if (event.getType() == CombatEvent::Type::Signature)
+		emit combatEventSent(event, playerNameToColor[event.getOwnerName()]);
 	else
-		emitExtensiveInfoSent(mech->getInfo());
+		emit combatEventSent(event, DefaultMessageColor);
 }
 
 void GraphicsMap::mechStateInfoReceived(const QString &message)
@@ -398,21 +523,46 @@ void GraphicsMap::mechStateInfoReceived(const QString &message)
 	                playerNameToColor[getCurrentMech()->getOwnerName()]);
 }
 
+/**
+ * Sets the zoom level for the current frame. The view is anchored under the mouse cursor.
+ */
 void GraphicsMap::scaleView()
 {
-	qreal initScale = scale;
-	if (scale > finalScale)
-		scale = qMax(finalScale, scale - SCALE_ANIM_SPEED);
-	else if (scale < finalScale)
-		scale = qMin(finalScale, scale + SCALE_ANIM_SPEED);
-	else
-		return;
+	qreal progress = qMin(1.0, (qreal)scaleAnimTime.elapsed() / SCALE_ANIM_TIME);
+	scale = startScale + (finalScale - startScale) * scaleEasing.valueForProgress(progress);
+	if (progress >= 1.0) {
+		scale = finalScale;
+		scaleTimer->stop();
+	}
 
-	QGraphicsView::scale(scale / initScale, scale / initScale);
-	update();
+	setTransform(QTransform::fromScale(scale, scale));
 }
 
-void GraphicsMap::scaleAnimFinished()
+/**
+ * Builds the map read by mapLoader, replacing the current one.
+ */
+void GraphicsMap::mapFileRead()
 {
-	delete sender();
+	MapLoader *loader = mapLoader;
+	mapLoader = nullptr;
+	loader->deleteLater();
+
+	if (!loader->succeeded()) {
+		emit mapLoadFailed();
+		return;
+	}
+
+	// nothing below may process events, so no timer or paint event sees the old map gone and the new one half built
+	if (mapLoaded)
+		clearMap();
+	bool built = Map::loadMap(loader->getContents());
+	if (built)
+		initMap();
+
+	if (!built) {
+		emit mapLoadFailed();
+		return;
+	}
+	mapLoaded = true;
+	emit mapHasBeenLoaded();
 }
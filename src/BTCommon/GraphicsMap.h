@@ -3,7 +3,10 @@
 
 #include <QtWidgets>
 #include "BTCommon/GraphicsFactory.h"
+#include "BTCommon/HexLayer.h"
+#include "BTCommon/HexUpdateTracker.h"
 #include "BTCommon/Map.h"
+#include "BTCommon/MapLoader.h"
 
 /**
  * \class GraphicsMap
@@ -15,6 +18,7 @@ Q_OBJECT;
 
 public:
 	GraphicsMap();
+	~GraphicsMap();
 
 	void createNewMap(int width, int height);
 	bool loadMap(const QString &mapFileName);
@@ -24,10 +28,11 @@ public:
 	void toggleCoordinates();
 	bool areCoordinatesVisible() const;
 
+	void updateHexTerrain(const Hex *hex);
+
 	void addMechToHex(MechEntity *mech, Hex *hex, Player *player);
 
 	QPair <QString, QColor> getMessage() const;
-	QPair <QString, QColor> getExtInfo() const;
 
 public slots:
 	void incScale(int steps = 1);
@@ -40,6 +45,8 @@ public slots:
 
 signals:
 	void mapHasBeenLoaded();
+	void mapLoadFailed();
+	void mapLoadStarted();
 	void mapCleared();
 
 	void hexClicked(Hex *hex);
@@ -57,7 +64,7 @@ signals:
 	void playerTurn(const Player *player);
 
 	void messageSent();
-	void extensiveInfoSent();
+	void combatEventSent(const CombatEvent &event, const QColor &color);
 
 private:
 	void initMap();
@@ -65,6 +72,8 @@ private:
 	void initScene();
 	void initGrid();
 	void initHexes();
+	void initHexItems();
+	void initHexLayers();
 	void initUnits();
 	void initUnit(MechEntity *mech);
 	void initScaling();
@@ -74,23 +83,36 @@ private:
 	static constexpr qreal DEFAULT_SCALE_SPEED = 0.1;			/**< Default zoom speed. */
 	static constexpr qreal MAX_SCALE_MULT = 6;				/**< Max zoom multiplier. */
 	static constexpr qreal MIN_SCALE_MULT = 0.1;				/**< Min zoom multiplier. */
-	static constexpr qreal SCALE_ANIM_SPEED = 0.02;				/**< Speed of zooming animation. */
-	static const int SCALE_ANIM_TIME = 600;					/**< Time of single zoom animation. */
-	static const int SCALE_ANIM_INTERVAL = 20;				/**< TIme between zoom animation steps. */
+	static const int SCALE_ANIM_TIME = 300;					/**< Time of single zoom animation. */
+	static const int SCALE_ANIM_INTERVAL = 16;				/**< Time between zoom animation steps (one frame). */
 
 	Grid *grid;
 
+	bool batchedRendering;							/**< Whether Hexes are drawn by HexLayers instead of separate GraphicsHexes. */
+	QList <HexLayer *> hexLayers;
+	MapLoader *mapLoader;							/**< Thread reading the map file being loaded, if any. */
+	HexLayer *terrainLayer;							/**< Layer caching pre-rendered terrain, if rendering is batched. */
+	HexUpdateTracker *hexUpdateTracker;
+	QGraphicsPathItem *walkRangeItem;					/**< Outline of the walk range, drawn as merged contours instead of per-Hex borders. */
+	QList <int> unitHexes;							/**< Hexes occupied by units when they were last updated. */
+	int trackedHex;								/**< Hex currently under the mouse, or -1. */
+
 	qreal maxScale;								/**< Max zoom level. */
 	qreal minScale;								/**< Min zoom level. */
 	qreal scale;								/**< Current zoom level. */
 	qreal scaleSpeed;							/**< Current speed of zooming. */
 	qreal finalScale;							/**< Destinated zoom level in the animation. */
+	qreal startScale;							/**< Zoom level the current animation started from. */
+	QTimer *scaleTimer;							/**< Drives the zoom animation; runs only while zooming. */
+	QElapsedTimer scaleAnimTime;						/**< Time elapsed since the animation was (re)targeted. */
+	QEasingCurve scaleEasing;
 	QPoint mousePosition;							/**< Current mouse position in the view. */
 
-	void changeScale(qreal scale);						/**< Changes finalScale to scale. */
+	void changeScale(qreal scale);						/**< Retargets the zoom animation to scale. */
 	void mouseMoveEvent(QMouseEvent *event);
 	void mousePressEvent(QMouseEvent *event);
 	void mouseReleaseEvent(QMouseEvent *event);
+	void leaveEvent(QEvent *event);
 	void wheelEvent(QWheelEvent *event);
 	void resizeEvent(QResizeEvent *event);
 
@@ -109,16 +131,15 @@ private:
 	void emitHexesNeedClearing();
 	void emitHexesNeedUpdating();
 	void emitMessageSent(const QString &message, const QColor &color = DefaultMessageColor);
-	void emitExtensiveInfoSent(const QString &message, const QColor &color = DefaultMessageColor);
 
 	void clearMap();
 
+	void trackHex(const QPointF &point);
+	void updateWalkRange();
+
 	QString message;
 	QColor messageColor;
 
-	QString extensiveInfo;
-	QColor extensiveInfoColor;
-
 	static const QHash <BTech::GamePhase, void (GraphicsMap::*)()> phaseToFunction;
 
 private slots:
@@ -128,11 +149,11 @@ private slots:
 	void hexNewAreaTracked(int hexNumber);
 
 	void mechInfoReceived();
-	void mechExtensiveInfoReceived();
+	void mechCombatEventReceived(const CombatEvent &event);
 	void mechStateInfoReceived(const QString &message);
 
 	void scaleView();
-	void scaleAnimFinished();
+	void mapFileRead();
 };
 
 #endif // GRAPHICSMAP_H
@@ -1,16 +1,23 @@
 #include "BTCommon/Grid.h"
 #include <limits>
 
-Grid::Grid(QVector <Hex *> &vector, int width, int height)
-	: width(width), height(height), hexes(vector)
+Grid::Grid(QVector <Hex *> &vector, int width, int height, MapCache *cache)
+	: width(width), height(height), hexes(vector), cache(cache)
 {
 	walkRangeVisible = false;
 	shootRangeVisible = false;
+	Hex::setOverlays(&overlays);
 
 	countPoints(width, height, GraphicsHex::getSize());
 	GraphicsEntity::setPathFinder(this);
 }
 
+Grid::~Grid()
+{
+	if (Hex::getOverlays() == &overlays)
+		Hex::setOverlays(nullptr);
+}
+
 void Grid::toggleGrid()
 {
 	GraphicsHex::setGridVisible(!isGridVisible());
@@ -40,32 +47,40 @@ bool Grid::areCoordinatesVisible() const
 
 QPoint Grid::getPosition(int number) const
 {
-	return GraphicsFactory::get(hexes[number])->pos().toPoint();
+	return GraphicsHex::getCenter(number / width, number % width);
 }
 
-LineOfSight Grid::getLineOfSight(const Hex *src, const Hex *dest) const
+/**
+ * Returns number of the Hex containing given point of the scene, or -1 if there is none.
+ * It is computed from the layout used in countPoints: Hex spans 2 * size horizontally
+ * and columns are 3/2 * size apart, so the point lies in at most two columns.
+ */
+int Grid::getHexNumber(const QPointF &point) const
 {
-	QList <QPair <const Hex *, const Hex *> > path = hexesBetween(src, dest);
-	LineOfSight line;
-
-	line.srcHeight = path.front().first->getHeight();
-	line.destHeight = path.back().first->getHeight();
+	const qreal size = GraphicsHex::getSize();
+	const int firstColumn = qMax(0, qCeil((point.x() - 2 * size) / (size * 3 / 2)));
+	const int lastColumn = qMin(width - 1, qFloor(point.x() / (size * 3 / 2)));
 
-	for (QPair <const Hex *, const Hex *> pair : path)
-		line += pairVisibilityScore(pair, src, dest);
-	if (path.size() > 2) {
-		if (line.srcHeight > line.destHeight)
-			line.heightBarrier = pairVisibilityScore(path[path.size() - 2], src, dest).heightBetween == line.srcHeight;
-		else if (line.srcHeight < line.destHeight)
-			line.heightBarrier = pairVisibilityScore(path[1], src, dest).heightBetween == line.destHeight;
+	for (int column = firstColumn; column <= lastColumn; ++column) {
+		int row = qFloor((point.y() / size - (column % 2 == 0)) / 2);
+		if (row < 0 || row >= height)
+			continue;
+		QPointF local = point - QPointF(size + column * size * 3 / 2,
+		                                size + (row * 2 + (column % 2 == 0)) * size);
+		if (qAbs(local.y()) <= size && qAbs(local.x()) <= size - qAbs(local.y()) / 2)
+			return row * width + column;
 	}
+	return -1;
+}
 
-	return line;
+LineOfSight Grid::getLineOfSight(const Hex *src, const Hex *dest) const
+{
+	return getLineOfSight(src->getNumber(), dest->getNumber());
 }
 
 LineOfSight Grid::getLineOfSight(int src, int dest) const
 {
-	return getLineOfSight(hexes[src], hexes[dest]);
+	return getSight(src, dest).lineOfSight;
 }
 
 bool Grid::lineOfSightExists(int src, int dest) const
@@ -75,15 +90,7 @@ bool Grid::lineOfSightExists(int src, int dest) const
 
 Direction Grid::getAttackDirection(int src, int dest) const
 {
-	if (src == dest)
-		return BTech::DirectionN;
-	QList <QPair <const Hex *, const Hex *> > path = hexesBetween(hexes[src], hexes[dest]);
-	const Hex *last = path[path.size() - 2].first;
-
-	for (Direction direction : BTech::directions)
-		if (last->getNumber() == nextHex(dest, direction))
-			return direction.behind();
-	return BTech::DirectionN;
+	return getSight(src, dest).attackDirection;
 }
 
 Direction Grid::getAttackDirection(Direction unitDirection, Direction attackDirection) const
@@ -100,15 +107,7 @@ Direction Grid::getAttackDirection(Direction unitDirection, Direction attackDire
 
 void Grid::countPoints(int width, int height, int hexS)	/// TODO - we want HEXES, not potatoes
 {
-	int leftBorder = GraphicsHex::getSize();
-	int upperBorder = GraphicsHex::getSize();
-
-	for (int i = 0; i < height; ++i) {
-		for (int j = 0; j < width; ++j)
-			GraphicsFactory::get(hexes[i * width + j])->setPos(
-				QPoint(leftBorder + j * GraphicsHex::getSize() * 3 / 2,
-				       upperBorder + (i * 2 + (j % 2 == 0)) * GraphicsHex::getSize()));
-	}
+	// GraphicsHexes are placed by GraphicsHex::getCenter when they are created
 	for (Hex *hex : hexes)
 		initHex(hex);
 }
@@ -218,13 +217,64 @@ QList <QPair <const Hex *, const Hex *> > Grid::hexesBetween(const Hex *src, con
 
 int Grid::getHexDistance(int src, int dest) const
 {
-	return hexesBetween(hexes[src], hexes[dest]).size() - 1;
+	return getSight(src, dest).distance;
+}
+
+MapCache::Sight Grid::getSight(int src, int dest) const
+{
+	if (const MapCache::Sight *sight = cache->find(src, dest))
+		return *sight;
+
+	// a full cache drops the pair, so the computed value is returned rather than looked up again
+	MapCache::Sight sight = countSight(src, dest);
+	cache->insert(src, dest, sight);
+	return sight;
+}
+
+/**
+ * Computes everything derived from the path between given Hexes, tracing the path only once.
+ */
+MapCache::Sight Grid::countSight(int src, int dest) const
+{
+	const Hex *srcHex = hexes[src];
+	const Hex *destHex = hexes[dest];
+	QList <QPair <const Hex *, const Hex *> > path = hexesBetween(srcHex, destHex);
+
+	MapCache::Sight sight;
+	sight.distance = path.size() - 1;
+
+	LineOfSight &line = sight.lineOfSight;
+	line.srcHeight = path.front().first->getHeight();
+	line.destHeight = path.back().first->getHeight();
+
+	for (QPair <const Hex *, const Hex *> pair : path)
+		line += pairVisibilityScore(pair, srcHex, destHex);
+	if (path.size() > 2) {
+		if (line.srcHeight > line.destHeight)
+			line.heightBarrier = pairVisibilityScore(path[path.size() - 2], srcHex, destHex).heightBetween == line.srcHeight;
+		else if (line.srcHeight < line.destHeight)
+			line.heightBarrier = pairVisibilityScore(path[1], srcHex, destHex).heightBetween == line.destHeight;
+	}
+
+	sight.attackDirection = BTech::DirectionN;
+	if (src != dest) {
+		const Hex *last = path[path.size() - 2].first;
+		for (Direction direction : BTech::directions) {
+			if (last->getNumber() == nextHex(dest, direction)) {
+				sight.attackDirection = direction.behind();
+				break;
+			}
+		}
+	}
+
+	return sight;
 }
 
 void Grid::showWalkRange(const MovementObject &movement)
 {
 	hideWalkRange();
 	drawWalkRange(movement);
+	walkRangeOutline = countOutline(overlays.getMoveObjectHexes());
 	walkRangeVisible = true;
 }
 
@@ -233,8 +283,67 @@ void Grid::hideWalkRange()
 	if (!walkRangeVisible)
 		return;
 	walkRangeVisible = false;
-	for (Hex *hex : hexes)
-		hex->removeMoveObject();
+	walkRangeOutline = QPainterPath();
+	for (int number : overlays.getMoveObjectHexes()) {
+		hexes[number]->removeMoveObject();
+		GraphicsHex::updateHex(hexes[number]);
+	}
+}
+
+/**
+ * Returns the boundary of the currently shown walk range as closed polygons, in the scene coordinates.
+ */
+QPainterPath Grid::getWalkRangeOutline() const
+{
+	return walkRangeOutline;
+}
+
+/**
+ * Merges edges of given Hexes that are not shared with another Hex from the list into closed polygons.
+ * Every Hex is walked around in the same order, so each boundary edge starts where the next one ends.
+ * Nodes are computed from the positions of the Hexes, so no GraphicsHex has to exist for them.
+ */
+QPainterPath Grid::countOutline(const QList <int> &numbers) const
+{
+	QSet <int> inside = numbers.toSet();
+	auto pointKey = [](const QPoint &point) {
+		return (quint64)(quint32)point.x() << 32 | (quint32)point.y();
+	};
+
+	QMultiHash <quint64, QPoint> edges;	// start of the edge -> end of the edge
+	for (int number : numbers) {
+		const int row = number / width;
+		const int column = number % width;
+		for (Direction direction : BTech::directions) {
+			const Hex *neighbour = hexes[number]->getNeighbour(direction);
+			if (neighbour != nullptr && inside.contains(neighbour->getNumber()))
+				continue;
+			edges.insert(pointKey(GraphicsHex::getAbsNode(row, column, direction - 1)),
+			             GraphicsHex::getAbsNode(row, column, direction));
+		}
+	}
+
+	QPainterPath outline;
+	while (!edges.isEmpty()) {
+		auto it = edges.begin();
+		QPoint start = QPoint((qint32)(it.key() >> 32), (qint32)(quint32)it.key());
+		QPoint current = it.value();
+		edges.erase(it);
+
+		QPolygon polygon;
+		polygon << start;
+		while (current != start) {
+			polygon << current;
+			it = edges.find(pointKey(current));
+			if (it == edges.end())
+				break;
+			current = it.value();
+			edges.erase(it);
+		}
+		outline.addPolygon(polygon);
+		outline.closeSubpath();
+	}
+	return outline;
 }
 
 void Grid::showShootRange(const MechEntity *mech)
@@ -249,22 +358,28 @@ void Grid::showShootRange(const MechEntity *mech)
 void Grid::hideShootRange()
 {
 	shootRangeVisible = false;
-	for (Hex *hex : hexes)
-		hex->removeAttackObject();
+	for (int number : overlays.getAttackableHexes()) {
+		hexes[number]->removeAttackObject();
+		GraphicsHex::updateHex(hexes[number]);
+	}
 }
 
 void Grid::hideAll()
 {
 	hideWalkRange();
 	hideShootRange();
-	for (Hex *hex : hexes)
-		hex->clear();
+	for (int number : overlays.getMoveObjectHexes()) {
+		hexes[number]->clear();
+		GraphicsHex::updateHex(hexes[number]);
+	}
 }
 
 void Grid::clearHexes()
 {
-	for (Hex *hex : hexes)
-		GraphicsFactory::get(hex)->setClicked(false);
+	for (int number : overlays.getClickedHexes()) {
+		overlays.setClicked(number, false);
+		GraphicsHex::updateHex(hexes[number]);
+	}
 }
 
 QList <int> Grid::getShootRange(int src, Direction direction) const
@@ -320,8 +435,10 @@ void Grid::drawShootRange(const MechEntity *mech)
 {
 	QList <int> vArc = getShootRange(mech->getCurrentPositionNumber(),
 	                                 mech->getTorsoDirection() + mech->getCurrentDirection());
-	for (int dest : vArc)
+	for (int dest : vArc) {
 		hexes[dest]->setAttackObject(getAttackObject(mech, hexes[dest]->getMech()));
+		GraphicsHex::updateHex(hexes[dest]);
+	}
 }
 
 void Grid::drawFriendlyMechs(const Player *player)
@@ -525,8 +642,10 @@ QList <MoveObject> Grid::getWalkRange(const MovementObject &movementObject) cons
 void Grid::drawWalkRange(const MovementObject &movement)
 {
 	QList <MoveObject> wRange = getWalkRange(movement);
-	for (MoveObject &object : wRange)
+	for (MoveObject &object : wRange) {
 		hexes[object.getDest().getNumber()]->setMoveObject(object);
+		GraphicsHex::updateHex(hexes[object.getDest().getNumber()]);
+	}
 }
 
 LineOfSight Grid::visibilityScore(const Hex *hex, const Hex *src, const Hex *dest) const
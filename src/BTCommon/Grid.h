@@ -5,6 +5,8 @@
 #include "BTCommon/GraphicsEntity.h"
 #include "BTCommon/GraphicsFactory.h"
 #include "BTCommon/GraphicsHex.h"
+#include "BTCommon/HexOverlays.h"
+#include "BTCommon/MapCache.h"
 #include "BTCommon/MechEntity.h"
 #include "BTCommon/Player.h"
 #include "BTCommon/Position.h"
@@ -13,12 +15,14 @@
 /**
  * \class Grid
  * Provides Map and GraphicsMap with Hex-managing functions. For this it requires reference to QVector of pointers to Hexes.
+ * Lines of sight, distances and attack directions are looked up in the MapCache of the Map, and computed only when missing.
  */
 class Grid : public PathFinder, public VisibilityManager
 {
 
 public:
-	Grid(QVector <Hex *> &vector, int width, int height);
+	Grid(QVector <Hex *> &vector, int width, int height, MapCache *cache);
+	~Grid();
 
 	void toggleGrid();
 	void setGridVisible(bool visible);
@@ -29,6 +33,7 @@ public:
 
 	void showWalkRange(const MovementObject &movement);
 	void hideWalkRange();
+	QPainterPath getWalkRangeOutline() const;
 	void showShootRange(const MechEntity *mech);
 	void hideShootRange();
 	void hideAll();
@@ -40,6 +45,7 @@ public:
 	void drawFriendlyMechs(const Player *player);
 
 	QPoint getPosition(int number) const;
+	int getHexNumber(const QPointF &point) const;
 
 	LineOfSight getLineOfSight(const Hex *src, const Hex *dest) const;
 	LineOfSight getLineOfSight(int src, int dest) const;
@@ -56,6 +62,11 @@ private:
 	int height;	/**< Number of Hexes in the column. */
 
 	QVector <Hex *> &hexes;
+	MapCache *cache;
+	HexOverlays overlays;	/**< Range and selection state of the highlighted Hexes only. */
+	QPainterPath walkRangeOutline;
+
+	QPainterPath countOutline(const QList <int> &numbers) const;
 
 	bool walkRangeVisible;
 	bool shootRangeVisible;
@@ -84,6 +95,8 @@ private:
 	int nextHex(int hex, Direction direction) const;
 	QList <QPair <const Hex *, const Hex *> > hexesBetween(const Hex *src, const Hex *dest) const;
 	int getHexDistance(int src, int dest) const;
+	MapCache::Sight getSight(int src, int dest) const;
+	MapCache::Sight countSight(int src, int dest) const;
 
 	LineOfSight visibilityScore(const Hex *hex, const Hex *src, const Hex *dest) const;
 	LineOfSight pairVisibilityScore(QPair <const Hex *, const Hex *> hexes, const Hex *src, const Hex *dest) const;
@@ -2,6 +2,7 @@
 #include "BTCommon/Hex.h"
 
 const VisibilityManager *Hex::visibilityManager = nullptr;
+HexOverlays *Hex::overlays = nullptr;
 
 /* constructor */
 Hex::Hex()
@@ -21,6 +22,18 @@ void Hex::setVisibilityManager(const VisibilityManager *manager)
 	visibilityManager = manager;
 }
 
+/* static member */
+void Hex::setOverlays(HexOverlays *overlays)
+{
+	Hex::overlays = overlays;
+}
+
+/* static member */
+HexOverlays * Hex::getOverlays()
+{
+	return overlays;
+}
+
 void Hex::setNeighbour(Direction direction, Hex * hex)
 {
 	neighbour[direction] = hex;
@@ -110,42 +123,45 @@ void Hex::removeMech()
 
 void Hex::setMoveObject(const MoveObject &move)
 {
-	moveObject[move.getDest().getDirection()] = move;
+	if (overlays != nullptr)
+		overlays->setMoveObject(number, move);
 }
 
 void Hex::setMoveObject(int areaNumber)
 {
-	currentMovementObjectNumber = areaNumber;
+	if (overlays != nullptr)
+		overlays->setCurrentArea(number, areaNumber);
 }
 
 MoveObject Hex::getMoveObject(Direction direction) const
 {
-	return moveObject[direction];
+	if (overlays == nullptr)
+		return MoveObject(BTech::MovementAction::Idle);
+	return overlays->getMoveObject(number, direction);
 }
 
 MoveObject Hex::getMoveObject() const
 {
-	return moveObject[currentMovementObjectNumber];
+	if (overlays == nullptr)
+		return MoveObject(BTech::MovementAction::Idle);
+	return overlays->getMoveObject(number);
 }
 
 bool Hex::hasMoveObject() const
 {
-	for (Direction direction : BTech::directions)
-		if (moveObject[direction].getAction() != BTech::MovementAction::Idle)
-			return true;
-	return false;
+	return overlays != nullptr && overlays->hasMoveObject(number);
 }
 
 void Hex::removeMoveObject()
 {
-	for (Direction direction : BTech::directions)
-		moveObject[direction] = MoveObject(BTech::MovementAction::Idle);
-	currentMovementObjectNumber = 0;
+	if (overlays != nullptr)
+		overlays->removeMoveObject(number);
 }
 
 void Hex::setAttackObject(const AttackObject &attack)
 {
-	attackable = true;
+	if (overlays != nullptr)
+		overlays->setAttackable(number, true);
 	if (getMech() == nullptr)
 		return;
 	getMech()->setAttackObject(attack);
@@ -163,14 +179,15 @@ bool Hex::hasAttackObject() const
 
 void Hex::removeAttackObject()
 {
-	attackable = false;
+	if (overlays != nullptr)
+		overlays->setAttackable(number, false);
 	if (getMech() != nullptr)
 		getMech()->removeAttackObject();
 }
 
 bool Hex::isAttackable() const
 {
-	return attackable;
+	return overlays != nullptr && overlays->isAttackable(number);
 }
 
 void Hex::clear()
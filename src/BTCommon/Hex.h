@@ -3,6 +3,7 @@
 
 #include <QtWidgets>
 #include "BTCommon/AttackObject.h"
+#include "BTCommon/HexOverlays.h"
 #include "BTCommon/MechEntity.h"
 #include "BTCommon/MoveObject.h"
 #include "BTCommon/Position.h"
@@ -17,6 +18,7 @@ namespace BTech {
  * This is a game-system representation of a hex.
  * Inheriting QObject is required, so the children can be killed, when the Hex is destroyed.
  * In order to make instances of this class work properly, static function setVisibilityManager require to be called.
+ * Walk and shoot range state is not stored in the Hex; it is kept in HexOverlays set with setOverlays.
  */
 class Hex : public QObject, public MechPosition
 {
@@ -26,6 +28,8 @@ public:
 	virtual ~Hex();
 
 	static void setVisibilityManager(const VisibilityManager *manager);
+	static void setOverlays(HexOverlays *overlays);
+	static HexOverlays * getOverlays();
 
 	void setNeighbour(Direction direction, Hex *neighbour);
 	Hex * getNeighbour(Direction direction) const;
@@ -65,6 +69,7 @@ public:
 
 private:
 	static const VisibilityManager *visibilityManager;
+	static HexOverlays *overlays;
 
 	Hex *neighbour[BTech::NODES_NUMBER];
 	int number;
@@ -78,10 +83,6 @@ private:
 
 	MechEntity *mech;
 
-	int currentMovementObjectNumber;
-	MoveObject moveObject[Direction::NUMBER];
-	bool attackable;
-
 	void clearData();
 };
 
@@ -0,0 +1,145 @@
+#include "BTCommon/GraphicsFactory.h"
+#include "BTCommon/HexLayer.h"
+#include <cmath>
+
+HexLayer::HexLayer(const QVector <Hex *> &hexes, int width, int height, GraphicsHex::LayerPaintFunction paintFunction, int zValue)
+	: hexes(hexes), width(width), height(height), paintFunction(paintFunction), tileCacheEnabled(false)
+{
+	tiles.setMaxCost(TILE_CACHE_LIMIT);
+
+	setZValue(zValue);
+	setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+	setAcceptHoverEvents(false);
+	setAcceptedMouseButtons(Qt::NoButton);
+}
+
+void HexLayer::setTileCacheEnabled(bool enabled)
+{
+	tileCacheEnabled = enabled;
+	invalidate();
+}
+
+/**
+ * Drops all cached tiles.
+ */
+void HexLayer::invalidate()
+{
+	tiles.clear();
+	update();
+}
+
+/**
+ * Drops cached tiles (on all levels) covering the Hex of given number.
+ */
+void HexLayer::invalidate(int number)
+{
+	const QRectF rect = hexRect(number);
+	const int firstColumn = qFloor(rect.left() / TILE_SIZE);
+	const int lastColumn = qFloor(rect.right() / TILE_SIZE);
+	const int firstRow = qFloor(rect.top() / TILE_SIZE);
+	const int lastRow = qFloor(rect.bottom() / TILE_SIZE);
+
+	for (int level = MIN_TILE_LEVEL; level <= MAX_TILE_LEVEL; ++level)
+		for (int row = firstRow; row <= lastRow; ++row)
+			for (int column = firstColumn; column <= lastColumn; ++column)
+				tiles.remove(tileKey(level, column, row));
+	update(rect);
+}
+
+QRectF HexLayer::hexRect(int number) const
+{
+	const int size = GraphicsHex::getSize();
+	return QRectF(GraphicsHex::getCenter(number / width, number % width) - QPoint(size, size), QSizeF(size * 2, size * 2))
+		.adjusted(-BORDER_MARGIN, -BORDER_MARGIN, BORDER_MARGIN, BORDER_MARGIN);
+}
+
+QRectF HexLayer::boundingRect() const
+{
+	const int size = GraphicsHex::getSize();
+	return QRectF(0, 0, (width - 1) * size * 3 / 2 + size * 2, (height * 2 + 1) * size)
+		.adjusted(-BORDER_MARGIN, -BORDER_MARGIN, BORDER_MARGIN, BORDER_MARGIN);
+}
+
+void HexLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *)
+{
+	if (!tileCacheEnabled) {
+		paintHexes(painter, option->exposedRect);
+		return;
+	}
+
+	qreal lod = qMax(option->levelOfDetailFromTransform(painter->worldTransform()), std::ldexp(1.0, MIN_TILE_LEVEL));
+	int level = qBound(MIN_TILE_LEVEL, qCeil(std::log2(lod)), MAX_TILE_LEVEL);
+	paintTiles(painter, option->exposedRect, level);
+}
+
+/**
+ * Paints Hexes intersecting given rect directly.
+ */
+void HexLayer::paintHexes(QPainter *painter, const QRectF &rect)
+{
+	const qreal size = GraphicsHex::getSize();
+	const QRectF exposed = rect.adjusted(-BORDER_MARGIN, -BORDER_MARGIN, BORDER_MARGIN, BORDER_MARGIN);
+
+	const int firstColumn = qMax(0, qCeil((exposed.left() - 2 * size) / (size * 3 / 2)));
+	const int lastColumn = qMin(width - 1, qFloor(exposed.right() / (size * 3 / 2)));
+	const int firstRow = qMax(0, qFloor((exposed.top() / size - 3) / 2));
+	const int lastRow = qMin(height - 1, qFloor(exposed.bottom() / size / 2));
+
+	for (int row = firstRow; row <= lastRow; ++row) {
+		for (int column = firstColumn; column <= lastColumn; ++column) {
+			const QPoint center = GraphicsHex::getCenter(row, column);
+			painter->translate(center);
+			const Hex *hex = hexes[row * width + column];
+			paintFunction(painter, hex, GraphicsFactory::find(hex));
+			painter->translate(-center);
+		}
+	}
+}
+
+/**
+ * Blits cached tiles of given level intersecting given rect, rendering the missing ones.
+ */
+void HexLayer::paintTiles(QPainter *painter, const QRectF &rect, int level)
+{
+	const QRectF exposed = rect & boundingRect();
+	const int firstColumn = qFloor(exposed.left() / TILE_SIZE);
+	const int lastColumn = qFloor(exposed.right() / TILE_SIZE);
+	const int firstRow = qFloor(exposed.top() / TILE_SIZE);
+	const int lastRow = qFloor(exposed.bottom() / TILE_SIZE);
+
+	for (int row = firstRow; row <= lastRow; ++row) {
+		for (int column = firstColumn; column <= lastColumn; ++column) {
+			QPixmap tile = getTile(level, column, row);
+			painter->drawPixmap(QRectF(column * TILE_SIZE, row * TILE_SIZE, TILE_SIZE, TILE_SIZE),
+			                    tile, tile.rect());
+		}
+	}
+}
+
+QPixmap HexLayer::getTile(int level, int column, int row)
+{
+	const quint64 key = tileKey(level, column, row);
+	if (QPixmap *tile = tiles.object(key))
+		return *tile;
+
+	const qreal scale = std::ldexp(1.0, level);
+	const int pixels = qCeil(TILE_SIZE * scale);
+	QPixmap tile(pixels, pixels);
+	tile.fill(Qt::transparent);
+
+	QPainter painter(&tile);
+	painter.scale(scale, scale);
+	painter.translate(-column * TILE_SIZE, -row * TILE_SIZE);
+	paintHexes(&painter, QRectF(column * TILE_SIZE, row * TILE_SIZE, TILE_SIZE, TILE_SIZE));
+	painter.end();
+
+	tiles.insert(key, new QPixmap(tile), pixels * pixels * 4 / 1024);
+	return tile;
+}
+
+/* static member */
+quint64 HexLayer::tileKey(int level, int column, int row)
+{
+	return (quint64)(level - MIN_TILE_LEVEL) << 48 | (quint64)(quint16)row << 24 | (quint16)column;
+}
+
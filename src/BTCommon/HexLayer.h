@@ -0,0 +1,52 @@
+#ifndef HEX_LAYER_H
+#define HEX_LAYER_H
+
+#include <QtWidgets>
+#include "BTCommon/GraphicsHex.h"
+
+/**
+ * \class HexLayer
+ * A single QGraphicsItem painting one layer (terrain, grid, range overlay, hover...) of all Hexes on the map.
+ * Hexes intersecting the exposed rectangle are found arithmetically from the layout used in Grid::countPoints,
+ * so GraphicsHexes do not have to be added to the scene at all. Hexes are painted from their data,
+ * and paint() never creates any GraphicsHex.
+ * A static layer (such as terrain) may cache its contents in pixmap tiles, rendered once per zoom level;
+ * it then has to be told about changed Hexes with invalidate().
+ */
+class HexLayer : public QGraphicsItem
+{
+
+public:
+	HexLayer(const QVector <Hex *> &hexes, int width, int height, GraphicsHex::LayerPaintFunction paintFunction, int zValue);
+
+	void setTileCacheEnabled(bool enabled);
+	void invalidate();
+	void invalidate(int number);
+
+	QRectF hexRect(int number) const;
+
+	QRectF boundingRect() const;
+	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr);
+
+private:
+	static const int BORDER_MARGIN = 2;					/**< Space reserved for borders drawn on the edge of a Hex. */
+	static const int TILE_SIZE = 512;					/**< Size of a cached tile in scene coordinates. */
+	static const int MIN_TILE_LEVEL = -4;					/**< Tiles are rendered at scales from 2^MIN_TILE_LEVEL... */
+	static const int MAX_TILE_LEVEL = 1;					/**< ...to 2^MAX_TILE_LEVEL. */
+	static const int TILE_CACHE_LIMIT = 64 * 1024;				/**< Max size of all cached tiles in kB. */
+
+	QVector <Hex *> hexes;
+	int width;								/**< Number of Hexes in the row. */
+	int height;								/**< Number of Hexes in the column. */
+	GraphicsHex::LayerPaintFunction paintFunction;
+
+	bool tileCacheEnabled;
+	QCache <quint64, QPixmap> tiles;					/**< Rendered tiles, keyed by level and tile coordinates. */
+
+	void paintHexes(QPainter *painter, const QRectF &rect);
+	void paintTiles(QPainter *painter, const QRectF &rect, int level);
+	QPixmap getTile(int level, int column, int row);
+	static quint64 tileKey(int level, int column, int row);
+};
+
+#endif // HEX_LAYER_H
@@ -0,0 +1,130 @@
+#include "BTCommon/HexOverlays.h"
+
+HexOverlays::Overlay::Overlay()
+	: currentArea(0), hasMoveObject(false), attackable(false), clicked(false)
+{}
+
+void HexOverlays::setMoveObject(int number, const MoveObject &move)
+{
+	Overlay &overlay = overlays[number];
+	overlay.moveObject[move.getDest().getDirection()] = move;
+	overlay.hasMoveObject = overlay.hasMoveObject || move.getAction() != BTech::MovementAction::Idle;
+	removeIfEmpty(overlays.find(number));
+}
+
+MoveObject HexOverlays::getMoveObject(int number, Direction direction) const
+{
+	auto it = overlays.constFind(number);
+	if (it == overlays.constEnd())
+		return MoveObject(BTech::MovementAction::Idle);
+	return it->moveObject[direction];
+}
+
+MoveObject HexOverlays::getMoveObject(int number) const
+{
+	auto it = overlays.constFind(number);
+	if (it == overlays.constEnd())
+		return MoveObject(BTech::MovementAction::Idle);
+	return it->moveObject[it->currentArea];
+}
+
+bool HexOverlays::hasMoveObject(int number) const
+{
+	auto it = overlays.constFind(number);
+	return it != overlays.constEnd() && it->hasMoveObject;
+}
+
+void HexOverlays::removeMoveObject(int number)
+{
+	auto it = overlays.find(number);
+	if (it == overlays.end())
+		return;
+	for (Direction direction : BTech::directions)
+		it->moveObject[direction] = MoveObject(BTech::MovementAction::Idle);
+	it->currentArea = 0;
+	it->hasMoveObject = false;
+	removeIfEmpty(it);
+}
+
+void HexOverlays::setCurrentArea(int number, int area)
+{
+	auto it = overlays.find(number);
+	if (it != overlays.end())
+		it->currentArea = area;
+}
+
+void HexOverlays::setAttackable(int number, bool attackable)
+{
+	if (attackable) {
+		overlays[number].attackable = true;
+		return;
+	}
+	auto it = overlays.find(number);
+	if (it == overlays.end())
+		return;
+	it->attackable = false;
+	removeIfEmpty(it);
+}
+
+bool HexOverlays::isAttackable(int number) const
+{
+	auto it = overlays.constFind(number);
+	return it != overlays.constEnd() && it->attackable;
+}
+
+void HexOverlays::setClicked(int number, bool clicked)
+{
+	if (clicked) {
+		overlays[number].clicked = true;
+		return;
+	}
+	auto it = overlays.find(number);
+	if (it == overlays.end())
+		return;
+	it->clicked = false;
+	removeIfEmpty(it);
+}
+
+bool HexOverlays::isClicked(int number) const
+{
+	auto it = overlays.constFind(number);
+	return it != overlays.constEnd() && it->clicked;
+}
+
+QList <int> HexOverlays::getMoveObjectHexes() const
+{
+	QList <int> result;
+	for (auto it = overlays.constBegin(); it != overlays.constEnd(); ++it)
+		if (it->hasMoveObject)
+			result << it.key();
+	return result;
+}
+
+QList <int> HexOverlays::getAttackableHexes() const
+{
+	QList <int> result;
+	for (auto it = overlays.constBegin(); it != overlays.constEnd(); ++it)
+		if (it->attackable)
+			result << it.key();
+	return result;
+}
+
+QList <int> HexOverlays::getClickedHexes() const
+{
+	QList <int> result;
+	for (auto it = overlays.constBegin(); it != overlays.constEnd(); ++it)
+		if (it->clicked)
+			result << it.key();
+	return result;
+}
+
+void HexOverlays::clear()
+{
+	overlays.clear();
+}
+
+void HexOverlays::removeIfEmpty(QHash <int, Overlay>::iterator it)
+{
+	if (!it->hasMoveObject && !it->attackable && !it->clicked)
+		overlays.erase(it);
+}
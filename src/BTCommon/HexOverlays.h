@@ -0,0 +1,52 @@
+#ifndef HEX_OVERLAYS_H
+#define HEX_OVERLAYS_H
+
+#include <QtCore>
+#include "BTCommon/MoveObject.h"
+#include "BTCommon/Position.h"
+
+/**
+ * \class HexOverlays
+ * Sparse storage of walk and shoot range (and selection) state, keyed by Hex number.
+ * Only highlighted Hexes have a record, so hiding a range touches only the Hexes that were highlighted.
+ */
+class HexOverlays
+{
+
+public:
+	void setMoveObject(int number, const MoveObject &move);
+	MoveObject getMoveObject(int number, Direction direction) const;
+	MoveObject getMoveObject(int number) const;
+	bool hasMoveObject(int number) const;
+	void removeMoveObject(int number);
+	void setCurrentArea(int number, int area);
+
+	void setAttackable(int number, bool attackable);
+	bool isAttackable(int number) const;
+
+	void setClicked(int number, bool clicked);
+	bool isClicked(int number) const;
+
+	QList <int> getMoveObjectHexes() const;
+	QList <int> getAttackableHexes() const;
+	QList <int> getClickedHexes() const;
+
+	void clear();
+
+private:
+	struct Overlay {
+		Overlay();
+
+		MoveObject moveObject[Direction::NUMBER];
+		int currentArea;						/**< Area of the Hex (equal to the Direction) currently under the mouse. */
+		bool hasMoveObject;
+		bool attackable;
+		bool clicked;
+	};
+
+	QHash <int, Overlay> overlays;
+
+	void removeIfEmpty(QHash <int, Overlay>::iterator it);
+};
+
+#endif // HEX_OVERLAYS_H
@@ -0,0 +1,57 @@
+#include "BTCommon/GraphicsHex.h"
+#include "BTCommon/HexUpdateTracker.h"
+
+HexUpdateTracker::HexUpdateTracker(QGraphicsScene *scene, const QVector <Hex *> &hexes, QObject *parent)
+	: QObject(parent), scene(scene), hexes(hexes), changed(hexes.size()), allChanged(false)
+{
+	timer = new QTimer(this);
+	timer->setSingleShot(true);
+	timer->setInterval(UPDATE_INTERVAL);
+	connect(timer, &QTimer::timeout, this, &HexUpdateTracker::flush);
+}
+
+void HexUpdateTracker::add(int number)
+{
+	if (allChanged || number < 0 || number >= changed.size() || changed.testBit(number))
+		return;
+	changed.setBit(number);
+	changedHexes << number;
+	schedule();
+}
+
+void HexUpdateTracker::addAll()
+{
+	allChanged = true;
+	schedule();
+}
+
+void HexUpdateTracker::schedule()
+{
+	if (!timer->isActive())
+		timer->start();
+}
+
+/**
+ * Merges bounding rects of changed Hexes into a single region and updates the scene with it.
+ * Rects are computed from the positions of the Hexes, so no GraphicsHex has to exist for them.
+ */
+void HexUpdateTracker::flush()
+{
+	if (allChanged) {
+		scene->update();
+	} else {
+		QRegion region;
+		for (int number : changedHexes) {
+			const QPoint point = hexes[number]->getPoint();
+			QRectF rect = GraphicsHex::getBoundingRect().translated(GraphicsHex::getCenter(point.y() - 1, point.x() - 1));
+			region += rect.adjusted(-BORDER_MARGIN, -BORDER_MARGIN, BORDER_MARGIN, BORDER_MARGIN).toAlignedRect();
+		}
+		for (const QRect &rect : region.rects())
+			scene->update(rect);
+	}
+
+	allChanged = false;
+	for (int number : changedHexes)
+		changed.clearBit(number);
+	changedHexes.clear();
+}
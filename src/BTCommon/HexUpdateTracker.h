@@ -0,0 +1,41 @@
+#ifndef HEX_UPDATE_TRACKER_H
+#define HEX_UPDATE_TRACKER_H
+
+#include <QtWidgets>
+#include "BTCommon/Hex.h"
+
+/**
+ * \class HexUpdateTracker
+ * Collects numbers of Hexes whose displayed state has changed and, once per frame,
+ * updates the scene with the region covered by them, instead of repainting the whole scene.
+ */
+class HexUpdateTracker : public QObject
+{
+Q_OBJECT;
+
+public:
+	HexUpdateTracker(QGraphicsScene *scene, const QVector <Hex *> &hexes, QObject *parent = nullptr);
+
+	void add(int number);
+	void addAll();
+
+private:
+	static const int UPDATE_INTERVAL = 16;					/**< Changes are flushed at most once per this many ms (one frame). */
+	static const int BORDER_MARGIN = 2;					/**< Space reserved for borders drawn on the edge of a Hex. */
+
+	QGraphicsScene *scene;
+	const QVector <Hex *> &hexes;
+
+	QBitArray changed;							/**< Whether Hex of given number is already in changedHexes. */
+	QVector <int> changedHexes;
+	bool allChanged;
+
+	QTimer *timer;
+
+	void schedule();
+
+private slots:
+	void flush();
+};
+
+#endif // HEX_UPDATE_TRACKER_H
@@ -71,6 +71,19 @@ void InfoBar::removeHex()
 	updateHexWindow();
 }
 
+/**
+ * Forgets the Hex and mech of a map being cleared, before a pending refresh could read them.
+ */
+void InfoBar::clear()
+{
+	refreshTimer->stop();
+	curMech = nullptr;
+	curHex = nullptr;
+	statWindowDirty = true;
+	hexWindowDirty = true;
+	refresh();
+}
+
 void InfoBar::update()
 {
 	updateStatWindow();
@@ -80,41 +93,14 @@ void InfoBar::update()
 
 void InfoBar::updateStatWindow()
 {
-	statWindow->setText(QString());
-	if (curMech != nullptr) {
-		statWindow->append(BTech::Strings::LabelType + tr(": %1").arg(curMech->getType()));
-		statWindow->append(BTech::Strings::LabelArmor + tr(": %1").arg(curMech->getArmorValue()));
-		statWindow->append(BTech::Strings::LabelMovePoints + tr(": %1/%2").arg(curMech->getMovePoints()).arg(curMech->getMaxMovePoints()));
-		statWindow->append(BTech::Strings::LabelRunPoints + tr(": %1/%2").arg(curMech->getRunPoints()).arg(curMech->getMaxRunPoints()));
-		statWindow->append(BTech::Strings::LabelJumpPoints + tr(": %1/%2").arg(curMech->getJumpPoints()).arg(curMech->getMaxJumpPoints()));
-
-		for (BTech::Range range : BTech::attackRanges)
-			statWindow->append(BTech::rangeStringChange[range] + " " + BTech::Strings::LabelDamage + tr(": %1").arg(curMech->getRangeDamage(range)));
-		statWindow->append(QString());
-
-		for (Effect effect : curMech->getEffects())
-			if (effect.isActive())
-				statWindow->append("\t" + static_cast<QString>(effect));
-	}
+	statWindowDirty = true;
+	scheduleRefresh();
 }
 
 void InfoBar::updateHexWindow()
 {
-	hexWindow->setText(QString());
-	if (curHex != nullptr) {
-		hexWindow->append(BTech::Strings::LabelHex + tr(" [%1, %2]").arg(curHex->getPoint().x()).arg(curHex->getPoint().y()));
-		hexWindow->append(BTech::Strings::LabelTerrain + tr(": %1").arg(BTech::terrainStringChange[curHex->getTerrain()]));
-		hexWindow->append(BTech::Strings::LabelHeight + tr(": %1").arg(curHex->getHeight()));
-		hexWindow->append(BTech::Strings::LabelUnits + ":");
-		if (curHex->getMech() == nullptr)
-			hexWindow->append(tr("\t") + BTech::Strings::LabelNone);
-		else
-			hexWindow->append("\t" + curHex->getMech()->getType() + "\t" + curHex->getMech()->getOwnerName());
-		if (curHex->hasMoveObject())
-			; //TODO
-		else if (curHex->hasAttackObject())
-			; //TODO
-	}
+	hexWindowDirty = true;
+	scheduleRefresh();
 }
 
 void InfoBar::initSettings()
@@ -127,6 +113,7 @@ void InfoBar::initSettings()
 	setMinimumSize(MINIMUM_WIDTH, MINIMUM_HEIGHT);
 	setContentsMargins(0, 0, 0, 0);
 	removeMech();
+	curHex = nullptr;
 	tX = -MAXIMUM_WIDTH;
 }
 
@@ -153,7 +140,9 @@ void InfoBar::initStatWindow()
 {
 	statWindow = new QTextEdit(this);
 	statWindow->setReadOnly(true);
-	statWindow->setPalette(QPalette(Qt::black));
+	QPalette statPalette(Qt::black);
+	statPalette.setColor(QPalette::Text, Qt::green);
+	statWindow->setPalette(statPalette);
 	statWindow->setBackgroundRole(QPalette::Window);
 	statWindow->setTextColor(Qt::green);
 	statWindow->setCursorWidth(0);
@@ -165,7 +154,9 @@ void InfoBar::initHexWindow()
 {
 	hexWindow = new QTextEdit(this);
 	hexWindow->setReadOnly(true);
-	hexWindow->setPalette(QPalette(Qt::black));
+	QPalette hexPalette(Qt::black);
+	hexPalette.setColor(QPalette::Text, Qt::green);
+	hexWindow->setPalette(hexPalette);
 	hexWindow->setBackgroundRole(QPalette::Window);
 	hexWindow->setTextColor(Qt::green);
 	hexWindow->setCursorWidth(0);
@@ -185,6 +176,84 @@ void InfoBar::initTimer()
 {
 	timer = new QTimer(this);
 	connect(timer, &QTimer::timeout, this, &InfoBar::advance);
+
+	statWindowDirty = false;
+	hexWindowDirty = false;
+	refreshTimer = new QTimer(this);
+	refreshTimer->setSingleShot(true);
+	refreshTimer->setInterval(REFRESH_INTERVAL);
+	connect(refreshTimer, &QTimer::timeout, this, &InfoBar::refresh);
+}
+
+QStringList InfoBar::buildStatLines() const
+{
+	QStringList lines;
+	if (curMech != nullptr) {
+		lines << BTech::Strings::LabelType + tr(": %1").arg(curMech->getType());
+		lines << BTech::Strings::LabelArmor + tr(": %1").arg(curMech->getArmorValue());
+		lines << BTech::Strings::LabelMovePoints + tr(": %1/%2").arg(curMech->getMovePoints()).arg(curMech->getMaxMovePoints());
+		lines << BTech::Strings::LabelRunPoints + tr(": %1/%2").arg(curMech->getRunPoints()).arg(curMech->getMaxRunPoints());
+		lines << BTech::Strings::LabelJumpPoints + tr(": %1/%2").arg(curMech->getJumpPoints()).arg(curMech->getMaxJumpPoints());
+
+		for (BTech::Range range : BTech::attackRanges)
+			lines << BTech::rangeStringChange[range] + " " + BTech::Strings::LabelDamage + tr(": %1").arg(curMech->getRangeDamage(range));
+		lines << QString();
+
+		for (Effect effect : curMech->getEffects())
+			if (effect.isActive())
+				lines << "\t" + static_cast<QString>(effect);
+	}
+	return lines;
+}
+
+QStringList InfoBar::buildHexLines() const
+{
+	QStringList lines;
+	if (curHex != nullptr) {
+		lines << BTech::Strings::LabelHex + tr(" [%1, %2]").arg(curHex->getPoint().x()).arg(curHex->getPoint().y());
+		lines << BTech::Strings::LabelTerrain + tr(": %1").arg(BTech::terrainStringChange[curHex->getTerrain()]);
+		lines << BTech::Strings::LabelHeight + tr(": %1").arg(curHex->getHeight());
+		lines << BTech::Strings::LabelUnits + ":";
+		if (curHex->getMech() == nullptr)
+			lines << tr("\t") + BTech::Strings::LabelNone;
+		else
+			lines << "\t" + curHex->getMech()->getType() + "\t" + curHex->getMech()->getOwnerName();
+		if (curHex->hasMoveObject())
+			; //TODO
+		else if (curHex->hasAttackObject())
+			; //TODO
+	}
+	return lines;
+}
+
+void InfoBar::scheduleRefresh()
+{
+	if (!refreshTimer->isActive())
+		refreshTimer->start();
+}
+
+/**
+ * Rebuilds the line lists of the dirty windows and touches the documents only if the lines have changed.
+ */
+void InfoBar::refresh()
+{
+	if (statWindowDirty) {
+		statWindowDirty = false;
+		QStringList lines = buildStatLines();
+		if (lines != statLines) {
+			statLines = lines;
+			statWindow->setPlainText(statLines.join('\n'));
+		}
+	}
+
+	if (hexWindowDirty) {
+		hexWindowDirty = false;
+		QStringList lines = buildHexLines();
+		if (lines != hexLines) {
+			hexLines = lines;
+			hexWindow->setPlainText(hexLines.join('\n'));
+		}
+	}
 }
 
 void InfoBar::advance()
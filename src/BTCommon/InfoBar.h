@@ -29,6 +29,7 @@ public slots:
 	void removeMech();
 	void setHex(const Hex *hex);
 	void removeHex();
+	void clear();
 	void update();
 
 	void updateStatWindow();
@@ -36,16 +37,21 @@ public slots:
 
 private:
 	QImage *image;
-	QVector <QString> information;
 	const MechEntity *curMech;
 	const Hex *curHex;
 
+	QStringList statLines;							/**< Lines currently displayed in statWindow. */
+	QStringList hexLines;							/**< Lines currently displayed in hexWindow. */
+	bool statWindowDirty;
+	bool hexWindowDirty;
+
 	QWidget *widget;
 	QVBoxLayout *layout;
 	QTextEdit *statWindow;
 	QTextEdit *hexWindow;
 	QLabel *imageWindow;
 	QTimer *timer;
+	QTimer *refreshTimer;
 
 	int tX;
 
@@ -54,6 +60,7 @@ private:
 	static const int MINIMUM_WIDTH = 0;
 	static const int MINIMUM_HEIGHT = 600;
 	static const int HIDE_SHOW_SPEED = 4;
+	static const int REFRESH_INTERVAL = 16;					/**< Windows are rebuilt at most once per this many ms (one frame). */
 
 	void initSettings();
 	void initWidget();
@@ -63,8 +70,13 @@ private:
 	void initLayout();
 	void initTimer();
 
+	QStringList buildStatLines() const;
+	QStringList buildHexLines() const;
+	void scheduleRefresh();
+
 private slots:
 	void advance();
+	void refresh();
 };
 
 #endif // INFOBAR_H
@@ -4,6 +4,7 @@
 const QColor Map::DefaultMessageColor = Qt::white;
 
 Map::Map()
+	: currentHex(nullptr)
 {
 	mapLoaded = false;
 }
@@ -33,16 +34,8 @@ void Map::createNewMap(int width, int height)
 	setMapFileName(QString());
 	hexWidth = width;
 	hexHeight = height;
-	for (int i = 0; i < height; ++i) {
-		for (int j = 0; j < width; ++j) {
-			Hex *hex = new Hex;
-			hex->setPoint({j + 1, i + 1});
-			hex->setNumber(i * width + j);
-			hex->setTerrain(BTech::Terrain::Clear);
-			hex->setHeight(0);
-			hexes << hex;
-		}
-	}
+	for (int i = 0; i < width * height; ++i)
+		hexes << newHex(i);
 	setDescription(QString());
 	allowedVersions = QList <BTech::GameVersion> ();
 	allowedVersions.append(BTech::GameVersion::BasicBattleDroids);
@@ -51,13 +44,24 @@ void Map::createNewMap(int width, int height)
 	setCurrentSubPhase(GameSubPhase::None);
 }
 
-bool Map::loadMap(const QString& mapFileName)
+bool Map::loadMap(const QString &mapFileName)
 {
-	QFile file(mapFileName);
-	if (!file.open(QIODevice::ReadOnly))
+	FileContents contents;
+	if (!readMapFile(mapFileName, contents))
+		return false;
+	return loadMap(contents);
+}
+
+/**
+ * Builds Hexes and Players from the decoded file. Has to be called from the GUI thread.
+ */
+bool Map::loadMap(const FileContents &contents)
+{
+	if (!buildMap(contents)) {
+		qWarning() << "Map file" << contents.fileName << "is corrupted";
+		Map::clearMap();
 		return false;
-	QDataStream in(&file);
-	in >> *this;
+	}
 
 	setCurrentPhase(BTech::GamePhase::None);
 	setCurrentSubPhase(GameSubPhase::None);
@@ -71,12 +75,34 @@ bool Map::loadMap(const QString& mapFileName)
 	}
 	initPlayers();
 
-	setMapFileName(mapFileName);
-	emitMessageSent(BTech::Messages::MapLoaded + mapFileName);
+	setMapFileName(contents.fileName);
+	emitMessageSent(BTech::Messages::MapLoaded + contents.fileName);
 	emitMessageSent(BTech::Messages::Separator);
 	return true;
 }
 
+/**
+ * Decodes the map file into plain data. It does not touch any QObject, so it is safe to call from a worker thread.
+ */
+/* static member */
+bool Map::readMapFile(const QString &mapFileName, FileContents &contents)
+{
+	QFile file(mapFileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+	// sections are copied out of the stream anyway, so the file is read in one go
+	QDataStream in(file.readAll());
+	readContents(in, contents);
+	if (in.status() != QDataStream::Ok) {
+		qWarning() << "Map file" << mapFileName << "is corrupted";
+		return false;
+	}
+
+	contents.fileName = mapFileName;
+	contents.cache.load(mapFileName, MapCache::hashContents(contents.width, contents.height, contents.terrain + contents.heights));
+	return true;
+}
+
 bool Map::isLoaded() const
 {
 	return mapLoaded;
@@ -175,21 +201,14 @@ BTech::GamePhase Map::getCurrentPhase() const
 	return currentPhase;
 }
 
+/**
+ * Maps are always saved in the newest format version.
+ */
 QDataStream & operator << (QDataStream &out, const Map &map)
 {
-	out << map.mapFileName << map.description << map.allowedVersions;
 	qDebug() << "Saving map" << map.mapFileName;
-
-	out << Rules::getVersion();
-
-	out << map.hexWidth << map.hexHeight;
-	for (Hex *hex : map.hexes)
-		out << *hex;
-
-	out << map.players.size();
-	for (Player *player : map.players)
-		out << *player;
-
+	out << Map::FILE_MAGIC << Map::FILE_VERSION;
+	map.writeSections(out);
 	qDebug() << "Done";
 
 	return out;
@@ -197,34 +216,261 @@ QDataStream & operator << (QDataStream &out, const Map &map)
 
 QDataStream & operator >> (QDataStream &in, Map &map)
 {
-	in >> map.mapFileName >> map.description >> map.allowedVersions;
-	qDebug() << "\nLoading map" << map.mapFileName << "...";
+	Map::FileContents contents;
+	Map::readContents(in, contents);
+	if (in.status() == QDataStream::Ok && !map.buildMap(contents))
+		in.setStatus(QDataStream::ReadCorruptData);
+	return in;
+}
 
-	BTech::GameVersion version;
-	in >> version;
-	Rules::setVersion(version);
+Hex * Map::newHex(int number) const
+{
+	Hex *hex = new Hex;
+	hex->setPoint({number % hexWidth + 1, number / hexWidth + 1});
+	hex->setNumber(number);
+	hex->setTerrain(BTech::Terrain::Clear);
+	hex->setHeight(0);
+	return hex;
+}
 
-	in >> map.hexWidth >> map.hexHeight;
+bool Map::buildMap(const FileContents &contents)
+{
+	mapFileName = contents.fileName;
+	description = contents.description;
+	cache = contents.cache;
+	allowedVersions = contents.allowedVersions;
+	Rules::setVersion(contents.version);
 
-	for (int i = 0; i < map.hexWidth * map.hexHeight; ++i) {
-		Hex *hex = new Hex;
-		in >> *hex;
-		map.hexes.append(hex);
+	hexWidth = contents.width;
+	hexHeight = contents.height;
+	int size = hexWidth * hexHeight;
+	hexes.reserve(size);
+	for (int i = 0; i < size; ++i) {
+		Hex *hex = newHex(i);
+		hex->setTerrain(static_cast<BTech::Terrain>(static_cast<quint8>(contents.terrain[i])));
+		hex->setHeight(static_cast<qint8>(contents.heights[i]));
+		hexes << hex;
 	}
 	qDebug() << "Hexes loaded.";
 
+	if (contents.players.isEmpty())
+		return true;
+	QDataStream in(contents.players);
 	int playersSize;
 	in >> playersSize;
-	for (int i = 0; i < playersSize; ++i) {
+	for (int i = 0; i < playersSize && in.status() == QDataStream::Ok; ++i) {
 		Player *player = new Player;
 		in >> *player;
-		map.players.append(player);
+		players.append(player);
 	}
-
 	qDebug() << "Players loaded.";
-	qDebug() << "Done.\n";
 
-	return in;
+	return in.status() == QDataStream::Ok;
+}
+
+/**
+ * Writes a map file straight from decoded contents, without building Hexes and Players.
+ * Used by tools producing maps, e.g. MapGenerator.
+ */
+/* static member */
+void Map::writeContents(QDataStream &out, const FileContents &contents)
+{
+	out << FILE_MAGIC << FILE_VERSION;
+	out << toUnderlying(Section::Info) << writeInfo(contents.fileName, contents.description, contents.allowedVersions, contents.version);
+	out << toUnderlying(Section::Hexes) << writeHexes(contents.width, contents.height, contents.terrain + contents.heights);
+	out << toUnderlying(Section::Players) << contents.players;
+	out << toUnderlying(Section::End) << QByteArray();
+}
+
+void Map::writeSections(QDataStream &out) const
+{
+	out << toUnderlying(Section::Info) << writeInfo(mapFileName, description, allowedVersions, Rules::getVersion());
+	out << toUnderlying(Section::Hexes) << writeHexes(hexWidth, hexHeight, getPlanes());
+	out << toUnderlying(Section::Players) << writePlayers();
+	out << toUnderlying(Section::End) << QByteArray();
+}
+
+/* static member */
+QByteArray Map::writeInfo(const QString &fileName,
+                          const QString &description,
+                          const QList <BTech::GameVersion> &allowedVersions,
+                          BTech::GameVersion version)
+{
+	QByteArray payload;
+	QDataStream out(&payload, QIODevice::WriteOnly);
+	out << fileName << description << allowedVersions << version;
+	return payload;
+}
+
+/**
+ * Number and coordinates of a Hex follow from its index, so only two planes are stored:
+ * terrain of all Hexes, followed by their heights (one byte each).
+ */
+/* static member */
+QByteArray Map::writeHexes(qint16 width, qint16 height, const QByteArray &planes)
+{
+	bool compressed = planes.size() >= COMPRESSION_THRESHOLD;
+
+	QByteArray payload;
+	QDataStream out(&payload, QIODevice::WriteOnly);
+	out << width << height << compressed << (compressed ? qCompress(planes) : planes);
+	return payload;
+}
+
+QByteArray Map::getPlanes() const
+{
+	QByteArray planes(2 * hexes.size(), Qt::Uninitialized);
+	for (int i = 0; i < hexes.size(); ++i) {
+		planes[i] = static_cast<char>(toUnderlying(hexes[i]->getTerrain()));
+		planes[hexes.size() + i] = static_cast<char>(static_cast<qint8>(hexes[i]->getHeight()));
+	}
+	return planes;
+}
+
+QByteArray Map::getContentHash() const
+{
+	return MapCache::hashContents(hexWidth, hexHeight, getPlanes());
+}
+
+/**
+ * Stores the derived data computed during the game next to the map file.
+ * Nothing is stored if the map was edited since it was loaded.
+ */
+void Map::saveCache()
+{
+	if (!hexes.isEmpty())
+		cache.save(mapFileName, getContentHash());
+}
+
+QByteArray Map::writePlayers() const
+{
+	QByteArray payload;
+	QDataStream out(&payload, QIODevice::WriteOnly);
+	out << players.size();
+	for (Player *player : players)
+		out << *player;
+	return payload;
+}
+
+/**
+ * Version 1 files have no header, so the format is recognized by the magic number at the beginning of the stream.
+ */
+/* static member */
+void Map::readContents(QDataStream &in, FileContents &contents)
+{
+	QByteArray header = in.device()->peek(sizeof(FILE_MAGIC));
+	if (header.size() == sizeof(FILE_MAGIC)
+	    && qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(header.constData())) == FILE_MAGIC)
+		readVersion2(in, contents);
+	else
+		readVersion1(in, contents);
+
+	int size = contents.width * contents.height;
+	if (contents.width <= 0 || contents.height <= 0
+	    || contents.terrain.size() != size || contents.heights.size() != size) {
+		in.setStatus(QDataStream::ReadCorruptData);
+		return;
+	}
+	for (char terrain : contents.terrain) {
+		if (static_cast<quint8>(terrain) < toUnderlying(BTech::Terrain::Clear)
+		    || static_cast<quint8>(terrain) > toUnderlying(BTech::Terrain::Water)) {
+			in.setStatus(QDataStream::ReadCorruptData);
+			return;
+		}
+	}
+}
+
+/**
+ * Version 1 stores Hexes one by one, followed by players in the same form as the players section of version 2.
+ */
+/* static member */
+void Map::readVersion1(QDataStream &in, FileContents &contents)
+{
+	in >> contents.fileName >> contents.description >> contents.allowedVersions >> contents.version;
+	qDebug() << "\nLoading map" << contents.fileName << "(version 1) ...";
+
+	in >> contents.width >> contents.height;
+	int size = qMax(0, contents.width * contents.height);
+	contents.terrain.reserve(size);
+	contents.heights.reserve(size);
+	for (int i = 0; i < size && in.status() == QDataStream::Ok; ++i) {
+		int number;
+		QPoint point;
+		int height;
+		BTech::Terrain terrain;
+		in >> number >> point >> height >> terrain;
+		contents.terrain.append(static_cast<char>(toUnderlying(terrain)));
+		contents.heights.append(static_cast<char>(static_cast<qint8>(height)));
+	}
+
+	if (in.status() == QDataStream::Ok)
+		contents.players = in.device()->readAll();
+}
+
+/* static member */
+void Map::readVersion2(QDataStream &in, FileContents &contents)
+{
+	quint32 magic;
+	quint16 version;
+	in >> magic >> version;
+	qDebug() << "\nLoading map (version" << version << ") ...";
+	if (version > FILE_VERSION) {
+		qWarning() << "Map file version" << version << "is not supported";
+		in.setStatus(QDataStream::ReadCorruptData);
+		return;
+	}
+
+	while (in.status() == QDataStream::Ok) {
+		quint8 section;
+		QByteArray payload;
+		in >> section >> payload;
+		if (in.status() != QDataStream::Ok || section == toUnderlying(Section::End))
+			break;
+
+		bool ok = true;
+		switch (static_cast<Section>(section)) {
+			case Section::Info:
+				ok = readInfo(payload, contents);
+				break;
+			case Section::Hexes:
+				ok = readHexes(payload, contents);
+				break;
+			case Section::Players:
+				contents.players = payload;
+				break;
+			default:
+				qDebug() << "Skipping unknown section" << section;
+		}
+		if (!ok)
+			in.setStatus(QDataStream::ReadCorruptData);
+	}
+}
+
+/* static member */
+bool Map::readInfo(const QByteArray &payload, FileContents &contents)
+{
+	QDataStream in(payload);
+	in >> contents.fileName >> contents.description >> contents.allowedVersions >> contents.version;
+	return in.status() == QDataStream::Ok;
+}
+
+/* static member */
+bool Map::readHexes(const QByteArray &payload, FileContents &contents)
+{
+	QDataStream in(payload);
+	bool compressed;
+	QByteArray planes;
+	in >> contents.width >> contents.height >> compressed >> planes;
+	if (compressed)
+		planes = qUncompress(planes);
+
+	int size = contents.width * contents.height;
+	if (in.status() != QDataStream::Ok || size <= 0 || planes.size() != 2 * size)
+		return false;
+
+	contents.terrain = planes.left(size);
+	contents.heights = planes.mid(size);
+	return true;
 }
 
 void Map::setMechsMoved(bool moved)
@@ -644,12 +890,16 @@ void Map::clearMap()
 {
 	qDebug() << "Clearing map...";
 
+	saveCache();
+	cache.reset();
+
 	qDeleteAll(players);
 	players.clear();
 	qDebug() << "\tplayers deleted";
 
 	qDeleteAll(hexes);
 	hexes.clear();
+	setCurrentHex(nullptr);
 	qDebug() << "\thexes deleted";
 
 	qDebug("Done.");
@@ -28,8 +28,28 @@ public:
 	QString & getDescriptionReference();
 	QList <BTech::GameVersion> & getAllowedVersionsRef();
 
+	/**
+	 * \struct FileContents
+	 * Map file decoded into plain data, before any Hex or Player is created.
+	 */
+	struct FileContents {
+		QString fileName;
+		QString description;
+		QList <BTech::GameVersion> allowedVersions;
+		BTech::GameVersion version = BTech::GameVersion::BasicBattleDroids;
+		qint16 width = 0;
+		qint16 height = 0;
+		QByteArray terrain;						/**< Terrain of each Hex, one byte per Hex. */
+		QByteArray heights;						/**< Height of each Hex, one signed byte per Hex. */
+		QByteArray players;						/**< Serialized players, built into Players on load. */
+		MapCache cache;							/**< Derived data stored next to the map file, empty if outdated. */
+	};
+
 	void createNewMap(int width, int height);
 	bool loadMap(const QString &mapFileName);
+	bool loadMap(const FileContents &contents);
+	static bool readMapFile(const QString &mapFileName, FileContents &contents);
+	static void writeContents(QDataStream &out, const FileContents &contents);
 	bool isLoaded() const;
 	void setMapFileName(const QString &path);
 	QString getMapFileName() const;
@@ -62,6 +82,10 @@ protected:
 	qint16 hexWidth;
 	qint16 hexHeight;
 
+	MapCache cache;
+	QByteArray getContentHash() const;
+	void saveCache();
+
 	QVector <Player *> players;
 	void countInitiative();
 	void setMechsMoved(bool moved);
@@ -147,8 +171,41 @@ private:
 
 	void resetCurrentValues();
 
+	Hex * newHex(int number) const;
+	bool buildMap(const FileContents &contents);
+
+	/**
+	 * \enum Section
+	 * Chunks of the map file, since version 2. Each is stored as its tag followed by a QByteArray payload,
+	 * so readers skip sections they do not know.
+	 */
+	enum class Section : quint8 {
+		End,
+		Info,
+		Hexes,
+		Players
+	};
+
+	void writeSections(QDataStream &out) const;
+	static QByteArray writeInfo(const QString &fileName,
+	                            const QString &description,
+	                            const QList <BTech::GameVersion> &allowedVersions,
+	                            BTech::GameVersion version);
+	static QByteArray writeHexes(qint16 width, qint16 height, const QByteArray &planes);
+	QByteArray getPlanes() const;
+	QByteArray writePlayers() const;
+	static void readContents(QDataStream &in, FileContents &contents);
+	static void readVersion1(QDataStream &in, FileContents &contents);
+	static void readVersion2(QDataStream &in, FileContents &contents);
+	static bool readInfo(const QByteArray &payload, FileContents &contents);
+	static bool readHexes(const QByteArray &payload, FileContents &contents);
+
 	static const qint16 DEFAULT_HEX_WIDTH = 40;
 	static const qint16 DEFAULT_HEX_HEIGHT = 40;
+
+	static const quint32 FILE_MAGIC = 0x42544D50;				/**< "BTMP"; version 1 files start with the file name instead. */
+	static const quint16 FILE_VERSION = 2;
+	static const int COMPRESSION_THRESHOLD = 4096;				/**< Hex planes of at least this size (in bytes) are compressed. */
 };
 
 #endif // MAP_H
@@ -0,0 +1,124 @@
+#include "BTCommon/FileWriter.h"
+#include "BTCommon/MapCache.h"
+
+MapCache::MapCache()
+	: changed(false)
+{}
+
+/**
+ * Returns hash of everything the cached data depends on. Planes are terrain and heights of all Hexes, one byte each.
+ */
+/* static member */
+QByteArray MapCache::hashContents(qint16 width, qint16 height, const QByteArray &planes)
+{
+	QByteArray size;
+	QDataStream out(&size, QIODevice::WriteOnly);
+	out << width << height;
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(size);
+	hash.addData(planes);
+	return hash.result();
+}
+
+/* static member */
+QString MapCache::getFileName(const QString &mapFileName)
+{
+	return mapFileName + FILE_SUFFIX;
+}
+
+void MapCache::reset(const QByteArray &contentHash)
+{
+	this->contentHash = contentHash;
+	sights.clear();
+	changed = false;
+}
+
+/**
+ * Reads the cache of given map file. If it is missing, outdated or corrupted, the cache is left empty,
+ * ready to be filled for the given content hash. Does not touch any QObject, so it is safe to call from a worker thread.
+ */
+bool MapCache::load(const QString &mapFileName, const QByteArray &contentHash)
+{
+	reset(contentHash);
+
+	QFile file(getFileName(mapFileName));
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream in(&file);
+	quint32 magic;
+	quint16 version;
+	QByteArray fileHash;
+	in >> magic >> version >> fileHash;
+	if (in.status() != QDataStream::Ok || magic != FILE_MAGIC || version != FILE_VERSION || fileHash != contentHash) {
+		qDebug() << "Map cache" << file.fileName() << "is outdated";
+		return false;
+	}
+
+	int size;
+	in >> size;
+	if (in.status() != QDataStream::Ok || size < 0 || size > MAX_SIGHTS) {
+		qWarning() << "Map cache" << file.fileName() << "is corrupted";
+		return false;
+	}
+	sights.reserve(size);
+	for (int i = 0; i < size && in.status() == QDataStream::Ok; ++i) {
+		quint64 key;
+		Sight sight;
+		LineOfSight &line = sight.lineOfSight;
+		in >> key >> line.lightWoods >> line.heavyWoods >> line.srcHeight >> line.destHeight
+		   >> line.heightBetween >> line.heightBarrier >> sight.distance >> sight.attackDirection;
+		sights.insert(key, sight);
+	}
+
+	if (in.status() != QDataStream::Ok) {
+		qWarning() << "Map cache" << file.fileName() << "is corrupted";
+		reset(contentHash);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Writes the cache next to given map file, if anything was computed since it was loaded.
+ * Nothing is written if the map has changed since the cache was filled (contentHash is the hash of the current contents).
+ */
+void MapCache::save(const QString &mapFileName, const QByteArray &contentHash)
+{
+	if (!changed || mapFileName.isEmpty() || contentHash != this->contentHash)
+		return;
+
+	QByteArray data;
+	QDataStream out(&data, QIODevice::WriteOnly);
+	out << FILE_MAGIC << FILE_VERSION << contentHash << sights.size();
+	for (auto it = sights.constBegin(); it != sights.constEnd(); ++it) {
+		const LineOfSight &line = it->lineOfSight;
+		out << it.key() << line.lightWoods << line.heavyWoods << line.srcHeight << line.destHeight
+		    << line.heightBetween << line.heightBarrier << it->distance << it->attackDirection;
+	}
+
+	// the cache is rebuilt when lost, so no backups are kept
+	FileWriter::write(getFileName(mapFileName), data, 0);
+	changed = false;
+}
+
+const MapCache::Sight * MapCache::find(int src, int dest) const
+{
+	auto it = sights.constFind(getKey(src, dest));
+	return it == sights.constEnd() ? nullptr : &*it;
+}
+
+void MapCache::insert(int src, int dest, const Sight &sight)
+{
+	if (sights.size() >= MAX_SIGHTS)
+		return;
+	sights.insert(getKey(src, dest), sight);
+	changed = true;
+}
+
+/* static member */
+quint64 MapCache::getKey(int src, int dest)
+{
+	return (static_cast<quint64>(static_cast<quint32>(src)) << 32) | static_cast<quint32>(dest);
+}
@@ -0,0 +1,54 @@
+#ifndef MAP_CACHE_H
+#define MAP_CACHE_H
+
+#include <QtCore>
+#include "BTCommon/Position.h"
+
+/**
+ * \class MapCache
+ * Lines of sight, distances and attack directions between pairs of Hexes, computed by Grid on first use.
+ * Filled cache is kept in a sidecar file next to the map file and reused on the next load, as long as
+ * the content hash of the map (its size, terrain and heights) has not changed. Otherwise it is silently rebuilt.
+ * At most MAX_SIGHTS pairs are kept; pairs queried after that are computed each time, so big maps
+ * do not grow the cache (and its file) with the square of their size.
+ */
+class MapCache
+{
+
+public:
+	/**
+	 * \struct Sight
+	 * Everything derived from the path between two Hexes.
+	 */
+	struct Sight {
+		LineOfSight lineOfSight;
+		int distance;
+		Direction attackDirection;
+	};
+
+	MapCache();
+
+	static QByteArray hashContents(qint16 width, qint16 height, const QByteArray &planes);
+	static QString getFileName(const QString &mapFileName);
+
+	void reset(const QByteArray &contentHash = QByteArray());
+	bool load(const QString &mapFileName, const QByteArray &contentHash);
+	void save(const QString &mapFileName, const QByteArray &contentHash);
+
+	const Sight * find(int src, int dest) const;
+	void insert(int src, int dest, const Sight &sight);
+
+private:
+	static quint64 getKey(int src, int dest);
+
+	static const quint32 FILE_MAGIC = 0x4254434D;				/**< "BTCM" */
+	static const quint16 FILE_VERSION = 1;
+	static const int MAX_SIGHTS = 1 << 18;					/**< About 10 MB of cached pairs. */
+	static constexpr const char *FILE_SUFFIX = ".cache";
+
+	QByteArray contentHash;							/**< Hash of the map contents the cached data was computed for. */
+	QHash <quint64, Sight> sights;
+	bool changed;								/**< Something was computed since the cache was loaded. */
+};
+
+#endif // MAP_CACHE_H
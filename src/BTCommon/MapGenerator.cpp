@@ -0,0 +1,195 @@
+#include "BTCommon/MapGenerator.h"
+
+MapGenerator::MapGenerator(const Parameters &parameters)
+	: parameters(parameters)
+{}
+
+Map::FileContents MapGenerator::generate()
+{
+	random.seed(parameters.seed);
+
+	Map::FileContents contents;
+	contents.description = QString("Generated %1x%2 map, seed %3")
+		.arg(parameters.width).arg(parameters.height).arg(parameters.seed);
+	contents.allowedVersions << BTech::GameVersion::BasicBattleDroids;
+	contents.width = parameters.width;
+	contents.height = parameters.height;
+
+	generateHexes(contents);
+	contents.players = generatePlayers(contents);
+
+	return contents;
+}
+
+bool MapGenerator::generateToFile(const QString &fileName)
+{
+	Map::FileContents contents = generate();
+	contents.fileName = fileName;
+
+	QSaveFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+	QDataStream out(&file);
+	Map::writeContents(out, contents);
+	return out.status() == QDataStream::Ok && file.commit();
+}
+
+/**
+ * Water fills everything below waterLevel; the rest is split evenly into heights from 0 to maxHeight.
+ * Woods and rough grow only on dry land, woods taking precedence.
+ */
+void MapGenerator::generateHexes(Map::FileContents &contents) const
+{
+	const int size = contents.width * contents.height;
+	contents.terrain.resize(size);
+	contents.heights.resize(size);
+
+	for (int row = 0; row < contents.height; ++row) {
+		for (int column = 0; column < contents.width; ++column) {
+			int number = row * contents.width + column;
+			BTech::Terrain terrain = BTech::Terrain::Clear;
+			int height = 0;
+
+			qreal level = noise(Layer::Height, row, column);
+			if (level < parameters.waterLevel) {
+				terrain = BTech::Terrain::Water;
+			} else {
+				height = qMin(parameters.maxHeight,
+				              static_cast<int>((level - parameters.waterLevel) / (1 - parameters.waterLevel) * (parameters.maxHeight + 1)));
+				qreal woods = noise(Layer::Woods, row, column);
+				if (woods >= parameters.heavyWoodsLevel)
+					terrain = BTech::Terrain::HeavyWoods;
+				else if (woods >= parameters.lightWoodsLevel)
+					terrain = BTech::Terrain::LightWoods;
+				else if (noise(Layer::Rough, row, column) >= parameters.roughLevel)
+					terrain = BTech::Terrain::Rough;
+			}
+
+			contents.terrain[number] = static_cast<char>(toUnderlying(terrain));
+			contents.heights[number] = static_cast<char>(static_cast<qint8>(height));
+		}
+	}
+}
+
+/**
+ * Player anchors are spread evenly on an ellipse around the center of the map; mechs are placed
+ * on the nearest dry Hexes around the anchor, facing the center.
+ */
+QByteArray MapGenerator::generatePlayers(const Map::FileContents &contents)
+{
+	QList <UID> uids;
+	for (int row = 0; row < MechModel::getRowCount(); ++row)
+		uids << MechModel::getRowUid(row);
+	if (uids.isEmpty())
+		qWarning() << "No mechs to place, players will have no units";
+
+	QList <Player *> players;
+	QSet <int> taken;
+	for (int i = 0; i < parameters.players; ++i) {
+		Player *player = new Player(QString("Player %1").arg(i + 1));
+		players << player;
+
+		qreal angle = 2 * M_PI * i / parameters.players;
+		int row = qBound(0, qRound((1 + ANCHOR_RADIUS * qSin(angle)) / 2 * (contents.height - 1)), contents.height - 1);
+		int column = qBound(0, qRound((1 + ANCHOR_RADIUS * qCos(angle)) / 2 * (contents.width - 1)), contents.width - 1);
+		Direction facing = (row < contents.height / 2) ? BTech::DirectionS : BTech::DirectionN;
+
+		for (int j = 0; j < parameters.mechsPerPlayer && !uids.isEmpty(); ++j) {
+			int number = findFreeHex(contents, taken, row, column);
+			if (number < 0)
+				break;
+			taken << number;
+
+			std::uniform_int_distribution <int> chooseMech(0, uids.size() - 1);
+			MechEntity *mech = new MechEntity(uids[chooseMech(random)]);
+			mech->setPosition(number, facing);
+			player->addMech(mech);
+		}
+	}
+
+	QByteArray payload;
+	QDataStream out(&payload, QIODevice::WriteOnly);
+	out << players.size();
+	for (Player *player : players)
+		out << *player;
+	qDeleteAll(players);
+	return payload;
+}
+
+/**
+ * Returns the dry, unoccupied Hex nearest to given one (searching square rings of growing radius), or -1 if there is none.
+ */
+int MapGenerator::findFreeHex(const Map::FileContents &contents, const QSet <int> &taken, int row, int column) const
+{
+	const char water = static_cast<char>(toUnderlying(BTech::Terrain::Water));
+	const int maxRadius = qMax(contents.width, contents.height);
+
+	for (int radius = 0; radius <= maxRadius; ++radius) {
+		for (int r = row - radius; r <= row + radius; ++r) {
+			if (r < 0 || r >= contents.height)
+				continue;
+			bool border = (r == row - radius || r == row + radius);
+			for (int c = column - radius; c <= column + radius; c += (border || radius == 0) ? 1 : 2 * radius) {
+				if (c < 0 || c >= contents.width)
+					continue;
+				int number = r * contents.width + c;
+				if (contents.terrain[number] != water && !taken.contains(number))
+					return number;
+			}
+		}
+	}
+	return -1;
+}
+
+/**
+ * Returns noise of given layer at given Hex, in range [0, 1).
+ * Even columns are shifted by half a Hex, as they are on the screen.
+ */
+qreal MapGenerator::noise(Layer layer, int row, int column) const
+{
+	qreal x = column / parameters.featureSize;
+	qreal y = (row + (column % 2 == 0) * 0.5) / parameters.featureSize;
+
+	qreal sum = 0;
+	qreal total = 0;
+	qreal amplitude = 1;
+	for (int octave = 0; octave < OCTAVES; ++octave) {
+		sum += amplitude * latticeNoise(layer, x, y);
+		total += amplitude;
+		amplitude /= 2;
+		x *= 2;
+		y *= 2;
+	}
+	return sum / total;
+}
+
+/**
+ * Smoothly interpolates random values assigned to the integer lattice.
+ */
+qreal MapGenerator::latticeNoise(Layer layer, qreal x, qreal y) const
+{
+	int x0 = qFloor(x);
+	int y0 = qFloor(y);
+	qreal fx = x - x0;
+	qreal fy = y - y0;
+	fx = fx * fx * (3 - 2 * fx);
+	fy = fy * fy * (3 - 2 * fy);
+
+	qreal top = latticeValue(layer, x0, y0) + (latticeValue(layer, x0 + 1, y0) - latticeValue(layer, x0, y0)) * fx;
+	qreal bottom = latticeValue(layer, x0, y0 + 1) + (latticeValue(layer, x0 + 1, y0 + 1) - latticeValue(layer, x0, y0 + 1)) * fx;
+	return top + (bottom - top) * fy;
+}
+
+/**
+ * Hashes lattice coordinates with the seed, so noise does not depend on the order Hexes are generated in.
+ */
+qreal MapGenerator::latticeValue(Layer layer, int x, int y) const
+{
+	quint32 hash = parameters.seed ^ (toUnderlying(layer) * 0x9E3779B9u);
+	hash ^= static_cast<quint32>(x) * 0x85EBCA6Bu;
+	hash = (hash ^ (hash >> 13)) * 0xC2B2AE35u;
+	hash ^= static_cast<quint32>(y) * 0x27D4EB2Fu;
+	hash = (hash ^ (hash >> 16)) * 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	return (hash & 0xFFFFFF) / static_cast<qreal>(0x1000000);
+}
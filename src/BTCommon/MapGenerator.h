@@ -0,0 +1,68 @@
+#ifndef MAP_GENERATOR_H
+#define MAP_GENERATOR_H
+
+#include <QtCore>
+#include <random>
+#include "BTCommon/Map.h"
+
+/**
+ * \class MapGenerator
+ * Produces maps of any size from a seed, for benchmarks and stress tests.
+ * Heights, woods, rough and water follow smooth value noise, so they form clusters instead of single Hexes.
+ * Every player gets mechs chosen from MechModel, placed around its own anchor on the map.
+ * The same parameters always produce the same map.
+ */
+class MapGenerator
+{
+
+public:
+	/**
+	 * \struct Parameters
+	 * Levels are thresholds on noise values in range [0, 1): the higher the level, the less of given terrain.
+	 */
+	struct Parameters {
+		qint16 width = 40;
+		qint16 height = 40;
+		quint32 seed = 0;
+		int players = 2;
+		int mechsPerPlayer = 4;
+		int maxHeight = 4;
+		qreal featureSize = 8;						/**< Approximate size of terrain clusters, in Hexes. */
+		qreal waterLevel = 0.25;					/**< Lowland below this level is flooded. */
+		qreal lightWoodsLevel = 0.6;
+		qreal heavyWoodsLevel = 0.72;
+		qreal roughLevel = 0.75;
+	};
+
+	MapGenerator(const Parameters &parameters);
+
+	Map::FileContents generate();
+	bool generateToFile(const QString &fileName);
+
+private:
+	/**
+	 * \enum Layer
+	 * Independent noise fields, each with its own salt mixed into the seed.
+	 */
+	enum class Layer : quint32 {
+		Height = 1,
+		Woods,
+		Rough
+	};
+
+	Parameters parameters;
+	std::mt19937 random;
+
+	void generateHexes(Map::FileContents &contents) const;
+	QByteArray generatePlayers(const Map::FileContents &contents);
+	int findFreeHex(const Map::FileContents &contents, const QSet <int> &taken, int row, int column) const;
+
+	qreal noise(Layer layer, int row, int column) const;
+	qreal latticeNoise(Layer layer, qreal x, qreal y) const;
+	qreal latticeValue(Layer layer, int x, int y) const;
+
+	static const int OCTAVES = 3;						/**< Noise is a sum of that many layers, each twice as detailed as the previous one. */
+	static constexpr qreal ANCHOR_RADIUS = 0.75;				/**< Distance of player anchors from the center, relative to the map size. */
+};
+
+#endif // MAP_GENERATOR_H
@@ -0,0 +1,23 @@
+#include "BTCommon/FileWriter.h"
+#include "BTCommon/MapLoader.h"
+
+MapLoader::MapLoader(const QString &fileName, QObject *parent)
+	: QThread(parent), fileName(fileName), success(false)
+{}
+
+bool MapLoader::succeeded() const
+{
+	return success;
+}
+
+const Map::FileContents & MapLoader::getContents() const
+{
+	return contents;
+}
+
+void MapLoader::run()
+{
+	// the map may still be waiting to be written
+	FileWriter::waitForFinished();
+	success = Map::readMapFile(fileName, contents);
+}
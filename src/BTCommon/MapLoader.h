@@ -0,0 +1,31 @@
+#ifndef MAP_LOADER_H
+#define MAP_LOADER_H
+
+#include <QtCore>
+#include "BTCommon/Map.h"
+
+/**
+ * \class MapLoader
+ * Reads and decodes a map file on its own thread, so the GUI stays responsive while big maps are parsed.
+ * When the thread finishes, the decoded contents are handed to Map::loadMap() on the GUI thread.
+ */
+class MapLoader : public QThread
+{
+Q_OBJECT;
+
+public:
+	MapLoader(const QString &fileName, QObject *parent = nullptr);
+
+	bool succeeded() const;
+	const Map::FileContents & getContents() const;
+
+protected:
+	void run();
+
+private:
+	QString fileName;
+	Map::FileContents contents;
+	bool success;
+};
+
+#endif // MAP_LOADER_H
@@ -6,6 +6,17 @@
  * \class Mech
  */
 
+const std::array <int, Mech::MECH_PARTS_NUMBER> Mech::damageTransferSlot {{
+	-1,                     // Head
+	MechModel::CenterTorso, // LeftTorso
+	MechModel::CenterTorso, // RightTorso
+	-1,                     // CenterTorso
+	MechModel::LeftTorso,   // LeftArm
+	MechModel::RightTorso,  // RightArm
+	MechModel::LeftTorso,   // LeftLeg
+	MechModel::RightTorso,  // RightLeg
+}};
+
 Mech::Mech()
 {
 	setBase(nullptr);
@@ -38,12 +49,19 @@ void Mech::setBase(const MechBase *base)
 	if (base == nullptr)
 		return;
 
-	for (const MechPartBase *mechPartBase : base->getMechParts())
+	for (const MechPartBase *mechPartBase : base->getMechParts()) {
 		this->parts.append(new MechPart(mechPartBase));
 
+		int slot = mechPartSlot(mechPartBase->getType(), mechPartBase->getSide());
+		if (slot >= 0)
+			partStates[slot] = {mechPartBase->getMaxArmorValue(), mechPartBase->getMaxInternalValue(), false};
+	}
+
 	this->armorValue = base->getArmorValue();
 	this->baseFireRange = base->getBaseFireRange();
 	this->heatSinksNumber = base->getHeatSinksNumber();
+
+	invalidateDerivedStats();
 }
 
 QString Mech::getType() const
@@ -108,12 +126,12 @@ BTech::Range Mech::distanceToRange(int distance) const
 
 int Mech::getRangeDamage(BTech::Range range) const
 {
-	return base->getRangeDamage(range);
+	return getDerivedStats().rangeDamage[toUnderlying(range)];
 }
 
 int Mech::getDamageValue(int distance) const
 {
-	return base->getDamageValue(distance);
+	return getRangeDamage(distanceToRange(distance));
 }
 
 QList <const MechPart *> Mech::getMechParts() const
@@ -126,20 +144,94 @@ QList <const MechPart *> Mech::getMechParts() const
 
 QList <const MechPart *> Mech::getMechParts(BTech::MechPartType type) const
 {
-	QList <const MechPart *> result;
-	for (MechPart *mechPart : parts)
-		if (mechPart->getType() == type)
-			result.append(mechPart);
-	return result;
+	return getDerivedStats().partsByType[toUnderlying(type)];
 }
 
 QList <const Weapon *> Mech::getWeapons() const
 {
-	QList <const Weapon *> result;
-	for (MechPart *mechPart : parts)
-		for (Weapon *weapon : mechPart->getWeapons())
-			result.append(weapon);
-	return result;
+	return getDerivedStats().weaponList;
+}
+
+void Mech::invalidateDerivedStats()
+{
+	derivedStats.valid = false;
+}
+
+int Mech::getDamageTransferSlot(int slot)
+{
+	return damageTransferSlot[slot];
+}
+
+int Mech::getMechPartArmorValue(int slot) const
+{
+	return partStates[slot].armorValue;
+}
+
+int Mech::getMechPartInternalValue(int slot) const
+{
+	return partStates[slot].internalValue;
+}
+
+bool Mech::isMechPartDestroyed(int slot) const
+{
+	return partStates[slot].destroyed;
+}
+
+/**
+ * Damage goes to the armor first, then to the internal structure.
+ * Whatever exceeds the internal structure of a part is transferred further
+ * (arms and legs to the torso on the same side, side torsos to the center torso).
+ */
+void Mech::applyDamage(int slot, int damage)
+{
+	while (slot >= 0 && damage > 0) {
+		MechPartState &state = partStates[slot];
+
+		int armorDamage = qMin(damage, state.armorValue);
+		state.armorValue -= armorDamage;
+		damage -= armorDamage;
+
+		int internalDamage = qMin(damage, state.internalValue);
+		state.internalValue -= internalDamage;
+		damage -= internalDamage;
+
+		if (state.internalValue == 0)
+			state.destroyed = true;
+
+		slot = damageTransferSlot[slot];
+	}
+
+	invalidateDerivedStats();
+}
+
+int Mech::mechPartSlot(BTech::MechPartType type, BTech::MechPartSide side)
+{
+	switch (type) {
+		case BTech::MechPartType::Head:
+			return MechModel::Head;
+		case BTech::MechPartType::Torso:
+			switch (side) {
+				case BTech::MechPartSide::Left:    return MechModel::LeftTorso;
+				case BTech::MechPartSide::Right:   return MechModel::RightTorso;
+				case BTech::MechPartSide::General:
+				case BTech::MechPartSide::Center:  return MechModel::CenterTorso;
+				default:                           return -1;
+			}
+		case BTech::MechPartType::Arm:
+			switch (side) {
+				case BTech::MechPartSide::Left:  return MechModel::LeftArm;
+				case BTech::MechPartSide::Right: return MechModel::RightArm;
+				default:                         return -1;
+			}
+		case BTech::MechPartType::Leg:
+			switch (side) {
+				case BTech::MechPartSide::Left:  return MechModel::LeftLeg;
+				case BTech::MechPartSide::Right: return MechModel::RightLeg;
+				default:                         return -1;
+			}
+		default:
+			return -1;
+	}
 }
 
 QDataStream & operator << (QDataStream &out, const Mech &mech)
@@ -147,8 +239,12 @@ QDataStream & operator << (QDataStream &out, const Mech &mech)
 	out << mech.base->getUid()
 	    << mech.armorValue << mech.baseFireRange << mech.heatSinksNumber;
 
-	for (MechPart *mechPart : mech.parts)
-		out << *mechPart;
+	for (MechPart *mechPart : mech.parts) {
+		// parts with no slot have no damage state; zeros keep the stream in step with operator >>
+		int slot = Mech::mechPartSlot(mechPart->getType(), mechPart->getSide());
+		const Mech::MechPartState state = (slot >= 0) ? mech.partStates[slot] : Mech::MechPartState();
+		out << state.armorValue << state.internalValue << *mechPart;
+	}
 
 	return out;
 }
@@ -160,8 +256,15 @@ QDataStream & operator >> (QDataStream &in, Mech &mech)
 	mech.setBase(MechModel::getMech(uid));
 	in >> mech.armorValue >> mech.baseFireRange >> mech.heatSinksNumber;
 
-	for (MechPart *mechPart : mech.parts)
-		in >> *mechPart;
+	for (MechPart *mechPart : mech.parts) {
+		int slot = Mech::mechPartSlot(mechPart->getType(), mechPart->getSide());
+		Mech::MechPartState state = {0, 0, false};
+		in >> state.armorValue >> state.internalValue >> *mechPart;
+		state.destroyed = (state.internalValue <= 0);
+		if (slot >= 0)
+			mech.partStates[slot] = state;
+	}
+	mech.invalidateDerivedStats();
 
 	return in;
 }
@@ -169,23 +272,58 @@ QDataStream & operator >> (QDataStream &in, Mech &mech)
 QList <MechPart *> Mech::findMechParts(BTech::MechPartType type)
 {
 	QList <MechPart *> result;
-
-	for (MechPart * mechPart : parts)
-		if (mechPart->getType() == type)
-			result.append(mechPart);
+	for (const MechPart *mechPart : getMechParts(type))
+		result.append(const_cast<MechPart *>(mechPart));
 	return result;
 }
 
 MechPart * Mech::findMechPart(BTech::MechPartType type, BTech::MechPartSide side)
 {
-	for (MechPart *mechPart : parts)
-		if (mechPart->getType() == type && mechPart->getSide() == side)
-			return mechPart;
-	return nullptr;
+	int slot = mechPartSlot(type, side);
+	if (slot < 0)
+		return nullptr;
+	return getDerivedStats().slots[slot];
+}
+
+const Mech::DerivedStats & Mech::getDerivedStats() const
+{
+	if (!derivedStats.valid)
+		updateDerivedStats();
+	return derivedStats;
 }
 
 void Mech::clearData()
 {
 	qDeleteAll(parts);
 	parts.clear();
+	partStates.fill({0, 0, false});
+	invalidateDerivedStats();
+}
+
+void Mech::updateDerivedStats() const
+{
+	DerivedStats &stats = derivedStats;
+
+	stats.weapons.clear();
+	stats.weaponList.clear();
+	stats.slots.fill(nullptr);
+	for (QList <const MechPart *> &typeParts : stats.partsByType)
+		typeParts.clear();
+
+	for (MechPart *mechPart : parts) {
+		int slot = mechPartSlot(mechPart->getType(), mechPart->getSide());
+		if (slot >= 0)
+			stats.slots[slot] = mechPart;
+		stats.partsByType[toUnderlying(mechPart->getType())].append(mechPart);
+
+		for (Weapon *weapon : mechPart->getWeapons()) {
+			stats.weapons.append(weapon);
+			stats.weaponList.append(weapon);
+		}
+	}
+
+	for (BTech::Range range : BTech::ranges)
+		stats.rangeDamage[toUnderlying(range)] = (base == nullptr) ? 0 : base->getRangeDamage(range);
+
+	stats.valid = true;
 }
@@ -50,6 +50,17 @@ public:
 	QList <const MechPart *> getMechParts(BTech::MechPartType type) const;
 	QList <const Weapon *> getWeapons() const;
 
+	void invalidateDerivedStats();
+
+	static const int MECH_PARTS_NUMBER = 8;
+	static int mechPartSlot(BTech::MechPartType type, BTech::MechPartSide side);
+	static int getDamageTransferSlot(int slot);
+
+	int getMechPartArmorValue(int slot) const;
+	int getMechPartInternalValue(int slot) const;
+	bool isMechPartDestroyed(int slot) const;
+	void applyDamage(int slot, int damage);
+
 	friend QDataStream & operator << (QDataStream &out, const Mech &mech);
 	friend QDataStream & operator >> (QDataStream &in, Mech &mech);
 
@@ -65,7 +76,40 @@ protected:
 
 	QList <MechPart *> parts;
 
+	/**
+	 * Damage state of a single mech part, indexed by the same slots as DerivedStats::slots.
+	 */
+	struct MechPartState {
+		int armorValue;
+		int internalValue;
+		bool destroyed;
+	};
+
+	std::array <MechPartState, MECH_PARTS_NUMBER> partStates {};		/**< Zeroed, so slots with no part are never read uninitialised. */
+
+	/**
+	 * Values derived from parts and weapons, rebuilt lazily after the base is changed, read or damaged.
+	 * Parts are indexed by the MechModel slots (MechModel::Head .. MechModel::RightLeg).
+	 */
+	struct DerivedStats {
+		QVector <Weapon *> weapons;
+		QList <const Weapon *> weaponList;
+		std::array <MechPart *, MECH_PARTS_NUMBER> slots;
+		std::array <QList <const MechPart *>, 4> partsByType;
+		std::array <int, 5> rangeDamage;
+		bool valid;
+	};
+
+	const DerivedStats & getDerivedStats() const;
+
 	void clearData();
+
+private:
+	static const std::array <int, MECH_PARTS_NUMBER> damageTransferSlot;
+
+	mutable DerivedStats derivedStats;
+
+	void updateDerivedStats() const;
 };
 
 #endif // MECH_H
@@ -304,8 +304,11 @@ UID MechBase::getUid() const
  * \class MechModel::MechModelNode
  */
 
-QList <MechBase *> MechModel::mechList;
+QList <UID> MechModel::rowUids;
 QHash <UID, MechBase *> MechModel::uidToMech;
+QHash <UID, CatalogFile::Entry> MechModel::unloadedMechs;
+QMultiHash <QString, UID> MechModel::typeToUid;
+const CatalogFile *MechModel::catalog = nullptr;
 
 MechModel::MechModelNode::MechModelNode(MechModelNode *parent, void *data, Level level)
 	: parent(parent), data(data), constData(nullptr), level(level)
@@ -357,6 +360,11 @@ MechModel::MechModelNode * MechModel::MechModelNode::getParent() const
 	return parent;
 }
 
+void MechModel::MechModelNode::setData(void *data)
+{
+	this->data = data;
+}
+
 MechModel::Level MechModel::MechModelNode::getLevel() const
 {
 	return level;
@@ -381,6 +389,16 @@ const WeaponBase * MechModel::MechModelNode::getWeaponBase() const
  * \class MechModel
  */
 
+/**
+ * Parts of a mech read from the catalog are added to the tree only when the mech is expanded.
+ */
+bool MechModel::canFetchMore(const QModelIndex &parent) const
+{
+	if (getLevel(parent) != Level::Mech)
+		return false;
+	return getNode(parent)->getMechBase() == nullptr;
+}
+
 int MechModel::columnCount(const QModelIndex &parent) const
 {
 	switch (getLevel(parent)) {
@@ -399,9 +417,12 @@ QVariant MechModel::data(const QModelIndex &index, int role) const
 	MechModelNode *modelNode = getNode(index);
 	switch (getLevel(index)) {
 		case Level::Mech: {
-			const MechBase *mech = modelNode->getMechBase();
+			// types are known from the catalog index, so listing them does not read the mechs
+			if (index.column() == Mech::Type)
+				return getType(rowUids[index.row()]);
+
+			const MechBase *mech = loadMech(rowUids[index.row()]);
 			switch (index.column()) {
-				case Mech::Type:               return mech->getType();
 				case Mech::Tonnage:            return mech->getTonnage();
 				case Mech::ArmorValue:         return mech->getArmorValue();
 				case Mech::MaxMovePoints:      return mech->getMaxMovePoints();
@@ -452,6 +473,29 @@ QVariant MechModel::data(const QModelIndex &index, int role) const
 	return QVariant();
 }
 
+/**
+ * Reads the mech of given row from the catalog, if needed, and inserts the nodes of its parts.
+ */
+void MechModel::fetchMore(const QModelIndex &parent)
+{
+	if (!canFetchMore(parent))
+		return;
+
+	MechBase *mech = loadMech(rowUids[parent.row()]);
+	if (mech == nullptr)
+		return;
+
+	MechModelNode *mechNode = getNode(parent);
+	if (mech->getMechParts().isEmpty()) {
+		mechNode->setData(mech);
+		return;
+	}
+	beginInsertRows(parent, 0, mech->getMechParts().count() - 1);
+	mechNode->setData(mech);
+	addMechPartNodes(mechNode, mech);
+	endInsertRows();
+}
+
 Qt::ItemFlags MechModel::flags(const QModelIndex &index) const
 {
 	if (!index.isValid())
@@ -464,6 +508,16 @@ Qt::ItemFlags MechModel::flags(const QModelIndex &index) const
 	return defaultFlags;
 }
 
+/**
+ * Every mech has parts, so there is no need to read a mech to tell it.
+ */
+bool MechModel::hasChildren(const QModelIndex &parent) const
+{
+	if (getLevel(parent) == Level::Mech)
+		return true;
+	return QAbstractItemModel::hasChildren(parent);
+}
+
 QModelIndex MechModel::index(int row, int column, const QModelIndex &parent) const
 {
 	if (!hasIndex(row, column, parent))
@@ -476,9 +530,9 @@ QModelIndex MechModel::index(int row, int column, const QModelIndex &parent) con
 bool MechModel::insertRows(int row, int count, const QModelIndex &parent)
 {
 	if (!parent.isValid()) {
+		int nameSuffix = 0;
 		beginInsertRows(parent, row, row + count - 1);
 		for (int i = 0; i < count; ++i) {
-			int nameSuffix = 0;
 			QString newName;
 			do {
 				++nameSuffix;
@@ -511,13 +565,11 @@ bool MechModel::removeRows(int row, int count, const QModelIndex &parent)
 {
 	if (!parent.isValid()) {
 		beginRemoveRows(parent, row, row + count - 1);
-		for (int i = 0; i < count; ++i) {
-			UID uid = mechList[i]->getUid();
-			uidToMech.remove(uid);
-			delete mechList.takeAt(i);
-			treeRoot->deleteChild(i);
-		}
+		for (int i = 0; i < count; ++i)
+			removeMechFromRow(row);
 		endRemoveRows();
+
+		return true;
 	}
 
 	return false;
@@ -537,9 +589,13 @@ bool MechModel::setData(const QModelIndex &index, const QVariant &value, int rol
 
 	switch (getLevel(index)) {
 		case Level::Mech: {
-			MechBase *mech = node->getMechBase();
+			MechBase *mech = loadMech(rowUids[index.row()]);
 			switch (index.column()) {
-				case Mech::Type:               mech->setType(value.toString()); break;
+				case Mech::Type:
+					typeToUid.remove(mech->getType(), mech->getUid());
+					mech->setType(value.toString());
+					typeToUid.insert(mech->getType(), mech->getUid());
+					break;
 				case Mech::Tonnage:            mech->setTonnage(value.toInt()); break;
 				case Mech::ArmorValue:         mech->setArmorValue(value.toInt()); break;
 				case Mech::MaxMovePoints:      mech->setMaxMovePoints(value.toInt()); break;
@@ -599,58 +655,119 @@ bool MechModel::saveToFile(const QString &fileName = BTech::Paths::MECHS_PATH)
 	return ::saveToFile(getInstance(), fileName);
 }
 
+/**
+ * Replaces all mechs with the ones indexed in given catalog. Mechs are read from the catalog on first use,
+ * so the catalog has to stay open until loadAll() is called or the model is loaded again.
+ */
+/* static member */
+void MechModel::attachCatalog(const CatalogFile *catalog)
+{
+	MechModel &mModel = getInstance();
+	mModel.beginResetModel();
+	mModel.clearModel();
+	mModel.initModel();
+
+	MechModel::catalog = catalog;
+	mModel.nextUid = catalog->getMechs().nextUid;
+	for (const CatalogFile::Entry &entry : catalog->getMechs().entries) {
+		rowUids << entry.uid;
+		unloadedMechs[entry.uid] = entry;
+		typeToUid.insert(entry.name, entry.uid);
+		mModel.treeRoot->appendChild(new MechModelNode(mModel.treeRoot, (void *)nullptr, Level::Mech));
+	}
+	mModel.endResetModel();
+}
+
+/* static member */
+UID MechModel::getNextUid()
+{
+	return getInstance().nextUid;
+}
+
 void MechModel::addNewMech()
 {
-	getInstance().insertRows(mechList.size(), 1, QModelIndex());
+	getInstance().insertRows(rowUids.size(), 1, QModelIndex());
 }
 
 bool MechModel::empty()
 {
-	return mechList.isEmpty();
+	return rowUids.isEmpty();
 }
 
 const MechBase * MechModel::getRow(int row)
 {
-	return mechList[row];
+	return loadMech(rowUids[row]);
+}
+
+int MechModel::getRowCount()
+{
+	return rowUids.size();
+}
+
+UID MechModel::getRowUid(int row)
+{
+	return rowUids[row];
+}
+
+/**
+ * Types are known from the catalog index, so this does not read the mech.
+ */
+QString MechModel::getRowType(int row)
+{
+	return getType(rowUids[row]);
 }
 
 const MechBase * MechModel::getMech(UID uid)
 {
-	return uidToMech.value(uid, nullptr);
+	return loadMech(uid);
 }
 
 const MechBase * MechModel::getMech(const QString &type)
 {
-	const MechBase *result = nullptr;
-	for (MechBase *cand : mechList)
-		if (cand->getType() == type)
-			result = cand;
-	if (result == nullptr)
+	if (!typeToUid.contains(type)) {
 		qWarning() << "Warning: MechBase" << type << "not found.";
-	return result;
+		return nullptr;
+	}
+	return loadMech(findUid(type));
 }
 
-const QList <MechBase *> & MechModel::getMechs()
+/**
+ * Reads all mechs that are still in the catalog, so it can be closed.
+ */
+void MechModel::loadAll()
 {
-	return mechList;
+	for (UID uid : rowUids)
+		loadMech(uid);
 }
 
 bool MechModel::hasMech(const QString &name)
 {
-	for (MechBase *mech : mechList)
-		if (mech->getType() == name)
-			return true;
-	return false;
+	return typeToUid.contains(name);
 }
 
-void MechModel::removeMech(UID uid)
+/**
+ * Appends already validated mechs, taking their ownership. The model is reset once
+ * for all of them, instead of emitting a signal for every row.
+ */
+void MechModel::importMechs(const QList <MechBase *> &mechs)
 {
-	for (int i = 0; i < mechList.count(); ++i) {
-		if (mechList[i]->getUid() == uid) {
-			getInstance().removeRows(i, 1, QModelIndex());
-			return;
-		}
+	MechModel &mModel = getInstance();
+
+	mModel.beginResetModel();
+	for (MechBase *mech : mechs) {
+		mech->setUid(mModel.nextUid++);
+		mModel.addMech(rowUids.size(), mech);
 	}
+	mModel.endResetModel();
+
+	mModel.changed = true;
+}
+
+void MechModel::removeMech(UID uid)
+{
+	int row = rowUids.indexOf(uid);
+	if (row != -1)
+		getInstance().removeRows(row, 1, QModelIndex());
 }
 
 void MechModel::addWeaponToMechPart(const QModelIndex &mechPartIndex, const WeaponBase *weapon)
@@ -715,9 +832,9 @@ MechModel::Level MechModel::getIndexType(const QModelIndex &index)
 
 QDataStream & operator << (QDataStream &out, const MechModel &mModel)
 {
-	out << mModel.nextUid << static_cast<UID>(mModel.mechList.count());
-	for (const MechBase *mech : mModel.mechList)
-		out << *mech;
+	out << mModel.nextUid << static_cast<UID>(mModel.rowUids.count());
+	for (UID uid : MechModel::rowUids)
+		out << *MechModel::loadMech(uid);
 	return out;
 }
 
@@ -761,8 +878,12 @@ MechModel::~MechModel()
 
 void MechModel::clearModel()
 {
-	qDeleteAll(mechList);
-	mechList.clear();
+	qDeleteAll(uidToMech);
+	uidToMech.clear();
+	unloadedMechs.clear();
+	typeToUid.clear();
+	rowUids.clear();
+	catalog = nullptr;
 	delete treeRoot;
 }
 
@@ -774,12 +895,17 @@ void MechModel::initModel()
 
 void MechModel::addMech(int row, MechBase *mech)
 {
-	mechList.insert(row, mech);
+	rowUids.insert(row, mech->getUid());
 	uidToMech[mech->getUid()] = mech;
+	typeToUid.insert(mech->getType(), mech->getUid());
 
 	MechModelNode *mechNode = new MechModelNode(treeRoot, mech, Level::Mech);
 	treeRoot->addChild(row, mechNode);
+	addMechPartNodes(mechNode, mech);
+}
 
+void MechModel::addMechPartNodes(MechModelNode *mechNode, MechBase *mech)
+{
 	for (MechPartBase *mechPartBase : mech->getMechParts()) {
 		MechModelNode *mechPartNode = new MechModelNode(mechNode, mechPartBase, Level::MechPart);
 		mechNode->appendChild(mechPartNode);
@@ -793,11 +919,66 @@ void MechModel::addMech(int row, MechBase *mech)
 
 void MechModel::removeMechFromRow(int row)
 {
-	uidToMech.remove(mechList[row]->getUid());
-	delete mechList.takeAt(row);
+	UID uid = rowUids.takeAt(row);
+	typeToUid.remove(getType(uid), uid);
+	unloadedMechs.remove(uid);
+	delete uidToMech.take(uid);
 	treeRoot->deleteChild(row);
 }
 
+/**
+ * Returns the mech of given UID, reading it from the catalog if it has not been read yet.
+ */
+/* static member */
+MechBase * MechModel::loadMech(UID uid)
+{
+	MechBase *mech = uidToMech.value(uid, nullptr);
+	if (mech != nullptr)
+		return mech;
+
+	auto it = unloadedMechs.find(uid);
+	if (it == unloadedMechs.end() || catalog == nullptr)
+		return nullptr;
+
+	QDataStream in(catalog->read(*it));
+	mech = new MechBase;
+	in >> *mech;
+	unloadedMechs.erase(it);
+	uidToMech[uid] = mech;
+	return mech;
+}
+
+/* static member */
+QString MechModel::getType(UID uid)
+{
+	const MechBase *mech = uidToMech.value(uid, nullptr);
+	if (mech != nullptr)
+		return mech->getType();
+	return unloadedMechs.value(uid).name;
+}
+
+/**
+ * Returns the UID of the mech of given type. If several mechs share the type, the one in the last row is taken.
+ */
+/* static member */
+UID MechModel::findUid(const QString &type)
+{
+	const QList <UID> uids = typeToUid.values(type);
+	if (uids.size() == 1)
+		return uids.first();
+
+	UID result = uids.first();
+	int resultRow = rowUids.indexOf(result);
+	for (UID uid : uids) {
+		const int row = rowUids.indexOf(uid);
+		if (row > resultRow) {
+			result = uid;
+			resultRow = row;
+		}
+	}
+	return result;
+}
+
 MechModel::Level MechModel::getLevel(const QModelIndex &index) const
 {
 	if (!index.isValid())
@@ -134,6 +134,7 @@ private:
 		MechModelNode * getChild(int idx) const;
 		MechModelNode * getParent() const;
 		int row() const;
+		void setData(void *data);
 
 		Level getLevel() const;
 		MechBase * getMechBase() const;
@@ -151,9 +152,12 @@ private:
 	MechModelNode *treeRoot;
 
 public:
+	bool canFetchMore(const QModelIndex &parent) const;
 	int columnCount(const QModelIndex &parent) const;
 	QVariant data(const QModelIndex &index, int role) const;
+	void fetchMore(const QModelIndex &parent);
 	Qt::ItemFlags flags(const QModelIndex &index) const;
+	bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
 	QModelIndex index(int row, int column, const QModelIndex &parent) const;
 	bool insertRows(int row, int count, const QModelIndex &parent);
 	QModelIndex parent(const QModelIndex &index) const;
@@ -167,15 +171,21 @@ public:
 	static MechModel & getInstance();
 	static bool loadFromFile(const QString &fileName);
 	static bool saveToFile(const QString &fileName);
+	static void attachCatalog(const CatalogFile *catalog);
+	static UID getNextUid();
 
 	static void addNewMech();
 	static bool empty();
 	static const MechBase * getRow(int row);
+	static int getRowCount();
+	static UID getRowUid(int row);
+	static QString getRowType(int row);
 	static const MechBase * getMech(UID uid);
 	static const MechBase * getMech(const QString &type);
-	static const QList <MechBase *> & getMechs();
+	static void loadAll();
 	static bool hasMech(const QString &name);
 	static void removeMech(UID uid);
+	static void importMechs(const QList <MechBase *> &mechs);
 
 	static void addWeaponToMechPart(const QModelIndex &mechPartIndex, const WeaponBase *weapon);
 	static void removeWeaponFromMechPart(const QModelIndex &mechPartIndex, int row);
@@ -231,7 +241,11 @@ private:
 	void initModel();
 
 	void addMech(int row, MechBase *mech);
+	void addMechPartNodes(MechModelNode *mechNode, MechBase *mech);
 	void removeMechFromRow(int row);
+	static MechBase * loadMech(UID uid);
+	static QString getType(UID uid);
+	static UID findUid(const QString &type);
 
 	Level getLevel(const QModelIndex &index) const;
 	MechModelNode * getNode(const QModelIndex &index) const;
@@ -240,8 +254,11 @@ private:
 	UID nextUid;
 
 	static const UID MinUid = 1;
-	static QList <MechBase *> mechList;
-	static QHash <UID, MechBase *> uidToMech;
+	static QList <UID> rowUids;						/**< UIDs of the mechs, in the order of rows. */
+	static QHash <UID, MechBase *> uidToMech;				/**< Mechs read so far. */
+	static QHash <UID, CatalogFile::Entry> unloadedMechs;			/**< Mechs still waiting in the catalog. */
+	static QMultiHash <QString, UID> typeToUid;				/**< Types need not be unique, so a type may index several mechs. */
+	static const CatalogFile *catalog;
 };
 
 inline uint qHash(MechModel::Level level)
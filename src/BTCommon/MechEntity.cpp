@@ -110,8 +110,8 @@ void MechEntity::move(const MoveObject &moveObject)
 		default:;
 	}
 
-	sendExtensiveInfo();
-	sendExtensiveInfo(QString(" ") + BTech::ExtInfo::MovedToHex.arg(moveObject.getDest().getNumber()));
+	sendSignature();
+	sendCombatEvent({CombatEvent::Type::MovedToHex, moveObject.getDest().getNumber()});
 }
 
 void MechEntity::turnRight()
@@ -187,7 +187,7 @@ const Weapon * MechEntity::getCurrentWeapon() const
 QList <const Weapon *> MechEntity::getReadyWeapons() const
 {
 	//TODO Effects
-	return Mech::getWeapons();
+	return getDerivedStats().weaponList;
 }
 
 QList <const Action *> MechEntity::getActions(BTech::GamePhase gamePhase) const
@@ -354,11 +354,6 @@ QString MechEntity::getInfo() const
 	return info;
 }
 
-QString MechEntity::getExtensiveInfo() const
-{
-	return extensiveInfo;
-}
-
 void MechEntity::init()
 {
 	mechPosition = nullptr;
@@ -383,9 +378,8 @@ void MechEntity::recover()
 	for (Effect &effect : editEffects())
 		effect.triggerTurnRecovery();
 
-	for (auto mechPart : parts)
-		for (Weapon *weapon : mechPart->getWeapons())
-			weapon->setUsed(false);
+	for (Weapon *weapon : getDerivedStats().weapons)
+		weapon->setUsed(false);
 }
 
 QDataStream & operator << (QDataStream &out, const MechEntity &mech)
@@ -415,12 +409,10 @@ QDataStream & operator >> (QDataStream &in, MechEntity &mech)
 
 Weapon * MechEntity::findWeapon(const Weapon *weapon)
 {
-	for (MechPart *mechPart : parts)
-		for (Weapon *current : mechPart->getWeapons())
-			if (const_cast<const Weapon *>(current) == weapon)
-				return current;
+	for (Weapon *current : getDerivedStats().weapons)
+		if (const_cast<const Weapon *>(current) == weapon)
+			return current;
 	return nullptr;
-
 }
 
 bool MechEntity::attackModifierCheck(const AttackObject &attack)
@@ -428,28 +420,23 @@ bool MechEntity::attackModifierCheck(const AttackObject &attack)
 	BTech::DiceRoll roll = BTech::d2Throw();
 	int total = attack.getTotalModifier(BTech::ModifierType::Attack);
 
-	sendExtensiveInfo(BTech::ExtInfo::AttackModifierCheck);
-	sendExtensiveInfo(BTech::ExtInfo::DisplayD2Roll.arg(roll));
+	sendCombatEvent(CombatEvent::Type::AttackModifierCheck);
+	sendCombatEvent({CombatEvent::Type::D2Roll, roll});
 
 	for (BTech::Modifier modifier : BTech::modifiers) {
 		int modifierValue = attack.getModifier(BTech::ModifierType::Attack, modifier);
 		if (modifierValue != 0) {
-			sendExtensiveInfo(BTech::ExtInfo::DisplayValue
-			                  .arg(BTech::modifierStringChange[modifier])
-			                  .arg(modifierValue));
+			sendCombatEvent({CombatEvent::Type::Modifier, toUnderlying(modifier), modifierValue});
 		}
 	}
 
-	sendExtensiveInfo(BTech::ExtInfo::SumOfTwoValues
-	                  .arg(roll)
-	                  .arg(total)
-	                  .arg(roll + total));
+	sendCombatEvent({CombatEvent::Type::Sum, roll, total});
 
 	if (roll + total > 12) {
-		sendExtensiveInfo(BTech::ExtInfo::AttackMissed);
+		sendCombatEvent(CombatEvent::Type::AttackMissed);
 		return false;
 	} else {
-		sendExtensiveInfo(BTech::ExtInfo::Hit);
+		sendCombatEvent(CombatEvent::Type::Hit);
 		return true;
 	}
 }
@@ -459,20 +446,16 @@ bool MechEntity::armorPenetrationCheck(const AttackObject &attack)
 	BTech::DiceRoll roll = BTech::d2Throw();
 	int total = attack.getTotalModifier(BTech::ModifierType::ArmorPenetration);
 
-	sendExtensiveInfo(BTech::ExtInfo::ArmorPenetrationCheck);
-	sendExtensiveInfo(BTech::ExtInfo::DisplayD2Roll.arg(roll));
-	sendExtensiveInfo(BTech::ExtInfo::DisplayGeneralModifier
-	                  .arg(total));
-	sendExtensiveInfo(BTech::ExtInfo::SubstractionOfTwoValues
-	                  .arg(roll)
-	                  .arg(total)
-	                  .arg(roll - total));
+	sendCombatEvent(CombatEvent::Type::ArmorPenetrationCheck);
+	sendCombatEvent({CombatEvent::Type::D2Roll, roll});
+	sendCombatEvent({CombatEvent::Type::GeneralModifier, total});
+	sendCombatEvent({CombatEvent::Type::Difference, roll, total});
 
 	if (roll < total) {
-		sendExtensiveInfo(BTech::ExtInfo::AttackDeflected);
+		sendCombatEvent(CombatEvent::Type::AttackDeflected);
 		return false;
 	} else {
-		sendExtensiveInfo(BTech::ExtInfo::ArmorPenetrated);
+		sendCombatEvent(CombatEvent::Type::ArmorPenetrated);
 		return true;
 	}
 }
@@ -481,42 +464,28 @@ MechEntity::HitLocation MechEntity::getHitLocation(const AttackObject &attack)
 {
 	BTech::DiceRoll roll = BTech::d2Throw();
 
-	sendExtensiveInfo(BTech::ExtInfo::DeterminingHitLocation);
-	sendExtensiveInfo(BTech::ExtInfo::DisplayD2Roll
-	                  .arg(roll));
-	sendExtensiveInfo(BTech::ExtInfo::DisplayAttackDirection
-	                  .arg(BTech::directionSideStringChange[attack.getDirection()]));
+	sendCombatEvent(CombatEvent::Type::DeterminingHitLocation);
+	sendCombatEvent({CombatEvent::Type::D2Roll, roll});
+	sendCombatEvent({CombatEvent::Type::AttackDirection, attack.getDirection()});
 
 	QPair <BTech::MechPartType, BTech::MechPartSide> hitLocation =
 		BTech::hitLocationTable[{roll, BTech::directionToMechPartSide[attack.getDirection()]}];
 
-	while (findMechPart(hitLocation.first, hitLocation.second)->hasEffect(BTech::EffectType::Destroyed)) {
-		switch (hitLocation.first) {
-			case BTech::MechPartType::Arm:
-			case BTech::MechPartType::Leg:
-				hitLocation.first = BTech::MechPartType::Torso;
-				break;
-			case BTech::MechPartType::Torso:
-				hitLocation.second = BTech::MechPartSide::Center;
-				break;
-			default:;
-		}
-	}
+	int slot = mechPartSlot(hitLocation.first, hitLocation.second);
+	while (isMechPartDestroyed(slot) && getDamageTransferSlot(slot) >= 0)
+		slot = getDamageTransferSlot(slot);
 
 	HitLocation result;
-	result.type = hitLocation.first;
-	result.side = hitLocation.second;
+	result.slot = slot;
 	result.critical = (roll == 2);
 
-	QString sideString;
-	if (result.side != BTech::MechPartSide::General)
-		sideString = BTech::mechPartSideStringChange[result.side];
+	const MechPart *mechPart = getDerivedStats().slots[slot];
 
 	if (result.critical)
-		sendExtensiveInfo(BTech::ExtInfo::Critical);
-	sendExtensiveInfo(BTech::ExtInfo::HitPart
-	                  .arg(sideString)
-	                  .arg(BTech::mechPartTypeStringChange[result.type]));
+		sendCombatEvent(CombatEvent::Type::Critical);
+	sendCombatEvent({CombatEvent::Type::HitPart,
+	                 toUnderlying(mechPart->getType()),
+	                 toUnderlying(mechPart->getSide())});
 
 	return result;
 }
@@ -527,10 +496,14 @@ void MechEntity::sendInfo(const QString &info)
 	emit infoSent();
 }
 
-void MechEntity::sendExtensiveInfo(const QString &info)
+void MechEntity::sendSignature()
 {
-	this->info = info;
-	emit extensiveInfoSent();
+	sendCombatEvent({CombatEvent::Type::Signature, getType(), ownerName});
+}
+
+void MechEntity::sendCombatEvent(const CombatEvent &event)
+{
+	emit combatEventSent(event);
 }
 
 QList <const Action *> MechEntity::getActions_BBD(BTech::GamePhase phase) const
@@ -619,15 +592,15 @@ QList <const Action *> MechEntity::getActions_ABD(BTech::GamePhase phase) const
 void MechEntity::resolveAttacks_BBD()
 {
 	if (!incomingAttacks.isEmpty())
-		sendExtensiveInfo(); /** signature */
+		sendSignature();
 	while (!incomingAttacks.empty()) {
 		AttackObject attack = incomingAttacks.first();
 		bool rollAgain = true;
 		Effect effect1, effect2;
 
-		sendExtensiveInfo(BTech::ExtInfo::AttackedBy
-		                  .arg(attack.getWeaponHolder()->getUnitName())
-		                  .arg(attack.getWeaponHolder()->getOwnerName()));
+		sendCombatEvent({CombatEvent::Type::AttackedBy,
+		                 attack.getWeaponHolder()->getUnitName(),
+		                 attack.getWeaponHolder()->getOwnerName()});
 
 		if (attackModifierCheck(attack) && armorPenetrationCheck(attack)) {
 			while (!hasEffect(BTech::EffectType::Destroyed) && rollAgain) {
@@ -685,13 +658,13 @@ void MechEntity::resolveAttacks_BBD()
 				}
 			}
 
-			sendExtensiveInfo(BTech::ExtInfo::ListEffects);
+			sendCombatEvent(CombatEvent::Type::ListEffects);
 			if (effect1.isActive()) {
-				sendExtensiveInfo(QString(effect1));
+				sendCombatEvent(effect1);
 				setEffect(effect1);
 			}
 			if (effect2.isActive()) {
-				sendExtensiveInfo(QString(effect2));
+				sendCombatEvent(effect2);
 				setEffect(effect2);
 			}
 
@@ -709,14 +682,14 @@ void MechEntity::resolveAttacks_BBD()
 void MechEntity::resolveAttacks_ABD()
 {
 	if (!incomingAttacks.isEmpty())
-		sendExtensiveInfo(); /** signature */
+		sendSignature();
 	while (!incomingAttacks.isEmpty()) {
 		AttackObject attack = incomingAttacks.first();
 		incomingAttacks.removeFirst();
 
 		if (attackModifierCheck(attack)) {
 			HitLocation hitLocation = getHitLocation(attack);
-			findMechPart(hitLocation.type, hitLocation.side)->applyDamage(attack.getDamage());
+			applyDamage(hitLocation.slot, attack.getDamage());
 		}
 	}
 }
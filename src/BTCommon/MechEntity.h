@@ -4,6 +4,7 @@
 #include <QtWidgets>
 #include "BTCommon/Action.h"
 #include "BTCommon/AttackObject.h"
+#include "BTCommon/CombatEvent.h"
 #include "BTCommon/CommonStrings.h"
 #include "BTCommon/Effect.h"
 #include "BTCommon/Mech.h"
@@ -91,7 +92,6 @@ public:
 	bool isFriendly() const;
 
 	QString getInfo() const;
-	QString getExtensiveInfo() const;
 
 	void init();
 	void clear();
@@ -103,7 +103,7 @@ public:
 signals:
 	void activated();
 	void infoSent();
-	void extensiveInfoSent();
+	void combatEventSent(const CombatEvent &event);
 	void stateInfoSent(const QString &message);
 
 private:
@@ -113,15 +113,15 @@ private:
 	bool armorPenetrationCheck(const AttackObject &attack);
 
 	struct HitLocation {
-		BTech::MechPartType type;
-		BTech::MechPartSide side;
+		int slot;
 		bool critical;
 	};
 
 	HitLocation getHitLocation(const AttackObject &attack);
 
 	void sendInfo(const QString &info);
-	void sendExtensiveInfo(const QString &info = QString());
+	void sendSignature();
+	void sendCombatEvent(const CombatEvent &event);
 
 	QString ownerName;
 	MechPosition *mechPosition;
@@ -142,7 +142,6 @@ private:
 	bool friendly;
 
 	QString info;
-	QString extensiveInfo;
 
 	const MovementAction *currentMovementAction;
 	const CombatAction *currentCombatAction;
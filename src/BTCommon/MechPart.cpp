@@ -58,32 +58,10 @@ void MechPart::setBase(const MechPartBase *base)
 {
 	clearData();
 	this->base = base;
-	armorValue = base->getMaxArmorValue();
-	internalValue = base->getMaxInternalValue();
 	for (const WeaponBase *weapon : base->getWeapons())
 		addWeapon(new Weapon(weapon));
 }
 
-void MechPart::setArmorValue(int value)
-{
-	this->armorValue = value;
-}
-
-int MechPart::getArmorValue() const
-{
-	return armorValue;
-}
-
-void MechPart::setInternalValue(int value)
-{
-	this->internalValue = value;
-}
-
-int MechPart::getInternalValue() const
-{
-	return internalValue;
-}
-
 void MechPart::addWeapon(Weapon *weapon)
 {
 	weapon->setWeaponHolder(this);
@@ -102,21 +80,6 @@ QList <Weapon *> MechPart::getWeapons()
 	return weapons;
 }
 
-void MechPart::applyDamage(int damage)
-{
-	int armorDamage = qMin(damage, armorValue);
-
-	damage -= armorDamage;
-	armorValue -= armorValue;
-
-	internalValue = qMin(internalValue - damage, 0);
-
-	if (internalValue == 0)
-		addEffect(Effect(BTech::EffectType::Destroyed,
-		                 BTech::EffectSource::Attack,
-		                 Effect::FOREVER));
-}
-
 void MechPart::triggerTurnRecovery()
 {
 	for (Effect effect : editEffects())
@@ -125,8 +88,6 @@ void MechPart::triggerTurnRecovery()
 
 QDataStream & operator << (QDataStream &out, const MechPart &mechPart)
 {
-	out << mechPart.armorValue << mechPart.internalValue;
-
 	out << static_cast<qint32>(mechPart.weapons.size());
 	for (Weapon *weapon : mechPart.weapons)
 		out << *weapon;
@@ -140,8 +101,6 @@ QDataStream & operator >> (QDataStream &in, MechPart &mechPart)
 {
 	mechPart.clearData();
 
-	in >> mechPart.armorValue >> mechPart.internalValue;
-
 	qint32 weaponsSize;
 	in >> weaponsSize;
 	for (int i = 0; i < weaponsSize; ++i) {
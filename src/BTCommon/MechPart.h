@@ -29,18 +29,10 @@ public:
 
 	void setBase(const MechPartBase *base);
 
-	void setArmorValue(int value);
-	int getArmorValue() const;
-
-	void setInternalValue(int value);
-	int getInternalValue() const;
-
 	void addWeapon(Weapon *weapon);
 	void removeWeapon(const Weapon *weapon);
 	QList <Weapon *> getWeapons();
 
-	void applyDamage(int damage);
-
 	void triggerTurnRecovery();
 	void attack(const AttackObject &attack);
 
@@ -50,8 +42,6 @@ public:
 private:
 	const MechPartBase *base;
 
-	int armorValue;
-	int internalValue;
 	QList <Weapon *> weapons;
 
 	void clearData();
@@ -277,17 +277,18 @@ int BTech::randomInt(int modulo)
 
 QString BTech::General::indexString(const QString &string, const QList <QString> &existing)
 {
-	QString unnamed = string;
-	int c = static_cast<int>('0');
-	bool exists;
-	do {
-		exists = false;
-		++c;
-		for (const QString &str : existing)
-			exists |= str == unnamed + static_cast<char>(c);
-	} while (exists);
-
-	return unnamed + static_cast<char>(c);
+	return indexString(string, existing.toSet());
+}
+
+/**
+ * Returns the string with the lowest positive index appended that is not in existing strings.
+ */
+QString BTech::General::indexString(const QString &string, const QSet <QString> &existing)
+{
+	int index = 1;
+	while (existing.contains(string + QString::number(index)))
+		++index;
+	return string + QString::number(index);
 }
 
 static QElapsedTimer worldTimer;
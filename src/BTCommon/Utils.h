@@ -273,6 +273,7 @@ namespace BTech {
 	*/
 	namespace General {
 		QString indexString(const QString &string, const QList <QString> &existing);
+		QString indexString(const QString &string, const QSet <QString> &existing);
 
 		// world timer
 		void startTime();
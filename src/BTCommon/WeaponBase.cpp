@@ -216,6 +216,11 @@ QDebug & operator << (QDebug &out, const WeaponBase &weapon)
 	return out;
 }
 
+void WeaponBase::setUid(UID uid)
+{
+	this->uid = uid;
+}
+
 UID WeaponBase::getUid() const
 {
 	return uid;
@@ -302,8 +307,11 @@ const QHash <BTech::Range, int> BTech::minimalMaxRange = {
  * \class WeaponModel
  */
 
-QList <WeaponBase *> WeaponModel::weaponList;
+QList <UID> WeaponModel::rowUids;
 QHash <UID, WeaponBase *> WeaponModel::uidToWeapon;
+QHash <UID, CatalogFile::Entry> WeaponModel::unloadedWeapons;
+QMultiHash <QString, UID> WeaponModel::nameToUid;
+const CatalogFile *WeaponModel::catalog = nullptr;
 
 int WeaponModel::columnCount(const QModelIndex &parent) const
 {
@@ -312,15 +320,20 @@ int WeaponModel::columnCount(const QModelIndex &parent) const
 	return ColumnCount;
 }
 
+/**
+ * Names are known from the catalog index, so listing them does not read the weapons.
+ */
 QVariant WeaponModel::data(const QModelIndex &index, int role) const
 {
 	if (!index.isValid())
 		return QVariant();
 
 	if (role == Qt::DisplayRole || role == Qt::EditRole) {
-		const WeaponBase *weapon = weaponList[index.row()];
+		if (index.column() == Name)
+			return getName(rowUids[index.row()]);
+
+		const WeaponBase *weapon = loadWeapon(rowUids[index.row()]);
 		switch (index.column()) {
-			case Name:                 return weapon->getName();
 			case Type:                 return toUnderlying(weapon->getWeaponType());
 			case MinimalRange:         return weapon->getMinRange();
 			case MaximalShortRange:    return weapon->getMaxRange(BTech::Range::Short);
@@ -356,7 +369,7 @@ bool WeaponModel::insertRows(int row, int count, const QModelIndex &)
 			weaponName = QString("%1 %2").arg(BTech::Strings::DefaultNewWeaponName).arg(nameSuffix);
 		} while (hasWeapon(weaponName));
 
-		weaponList.insert(row + i, new WeaponBase(weaponName, nextUid++));
+		addWeapon(row + i, new WeaponBase(weaponName, nextUid++));
 	}
 	endInsertRows();
 
@@ -375,7 +388,7 @@ bool WeaponModel::removeRows(int row, int count, const QModelIndex &)
 
 int WeaponModel::rowCount(const QModelIndex &) const
 {
-	return weaponList.count();
+	return rowUids.count();
 }
 
 bool WeaponModel::setData(const QModelIndex &index, const QVariant &value, int role)
@@ -383,9 +396,13 @@ bool WeaponModel::setData(const QModelIndex &index, const QVariant &value, int r
 	if (!index.isValid() || role != Qt::EditRole)
 		return false;
 
-	WeaponBase *weapon = weaponList[index.row()];
+	WeaponBase *weapon = loadWeapon(rowUids[index.row()]);
 	switch (index.column()) {
-		case Name:                 weapon->setName(value.toString()); break;
+		case Name:
+			nameToUid.remove(weapon->getName(), weapon->getUid());
+			weapon->setName(value.toString());
+			nameToUid.insert(weapon->getName(), weapon->getUid());
+			break;
 		case Type:                 weapon->setWeaponType(static_cast<BTech::WeaponType>(value.toInt())); break;
 		case MinimalRange:         weapon->setMinRange(value.toInt()); break;
 		case MaximalShortRange:    weapon->setMaxRange(BTech::Range::Short, value.toInt()); break;
@@ -431,24 +448,69 @@ bool WeaponModel::saveToFile(const QString &fileName = BTech::Paths::WEAPONS_PAT
 	return ::saveToFile(getInstance(), fileName);
 }
 
+/**
+ * Replaces all weapons with the ones indexed in given catalog. Weapons are read from the catalog on first use,
+ * so the catalog has to stay open until loadAll() is called or the model is loaded again.
+ */
+/* static member */
+void WeaponModel::attachCatalog(const CatalogFile *catalog)
+{
+	WeaponModel &wModel = getInstance();
+	wModel.beginResetModel();
+	wModel.clearModel();
+
+	WeaponModel::catalog = catalog;
+	wModel.nextUid = catalog->getWeapons().nextUid;
+	for (const CatalogFile::Entry &entry : catalog->getWeapons().entries) {
+		rowUids << entry.uid;
+		unloadedWeapons[entry.uid] = entry;
+		nameToUid.insert(entry.name, entry.uid);
+	}
+	wModel.endResetModel();
+}
+
+/* static member */
+UID WeaponModel::getNextUid()
+{
+	return getInstance().nextUid;
+}
+
 void WeaponModel::addNewWeapon()
 {
-	getInstance().insertRows(weaponList.size(), 1);
+	getInstance().insertRows(rowUids.size(), 1);
 }
 
 bool WeaponModel::empty()
 {
-	return weaponList.empty();
+	return rowUids.empty();
 }
 
 const WeaponBase * WeaponModel::getRow(int row)
 {
-	return weaponList[row];
+	return loadWeapon(rowUids[row]);
+}
+
+int WeaponModel::getRowCount()
+{
+	return rowUids.size();
+}
+
+UID WeaponModel::getRowUid(int row)
+{
+	return rowUids[row];
+}
+
+/**
+ * Names are known from the catalog index, so this does not read the weapon.
+ */
+QString WeaponModel::getRowName(int row)
+{
+	return getName(rowUids[row]);
 }
 
 const WeaponBase * WeaponModel::getWeapon(UID uid)
 {
-	return uidToWeapon.value(uid, nullptr);
+	return loadWeapon(uid);
 }
 
 const WeaponBase * WeaponModel::getWeapon(const QModelIndex &index)
@@ -458,38 +520,53 @@ const WeaponBase * WeaponModel::getWeapon(const QModelIndex &index)
 
 const WeaponBase * WeaponModel::getWeapon(const QString &name)
 {
-	const WeaponBase *result = nullptr;
-	for (const WeaponBase *weapon : weaponList) {
-		if (weapon->getName() == name)
-			result = weapon;
-	}
-	return result;
+	if (!nameToUid.contains(name))
+		return nullptr;
+	return loadWeapon(findUid(name));
 }
 
-const QList <WeaponBase *> & WeaponModel::getWeapons()
+/**
+ * Reads all weapons that are still in the catalog, so it can be closed.
+ */
+void WeaponModel::loadAll()
 {
-	return weaponList;
+	for (UID uid : rowUids)
+		loadWeapon(uid);
 }
 
 bool WeaponModel::hasWeapon(const QString &name)
 {
-	return getWeapon(name) != nullptr;
+	return nameToUid.contains(name);
 }
 
-void WeaponModel::removeWeapon(UID uid)
+/**
+ * Appends already validated weapons, taking their ownership. The model is reset once
+ * for all of them, instead of emitting a signal for every row.
+ */
+void WeaponModel::importWeapons(const QList <WeaponBase *> &weapons)
 {
 	WeaponModel &wModel = getInstance();
 
-	for (int i = 0; i < weaponList.count(); ++i) {
-		if (weaponList[i]->getUid() == uid) {
-			wModel.beginRemoveRows(QModelIndex(), i, i);
-			delete weaponList.takeAt(i);
-			wModel.endRemoveRows();
-
-			uidToWeapon.remove(uid);
-			return;
-		}
+	wModel.beginResetModel();
+	for (WeaponBase *weapon : weapons) {
+		weapon->setUid(wModel.nextUid++);
+		wModel.addWeapon(rowUids.size(), weapon);
 	}
+	wModel.endResetModel();
+
+	wModel.changed = true;
+}
+
+void WeaponModel::removeWeapon(UID uid)
+{
+	WeaponModel &wModel = getInstance();
+
+	int row = rowUids.indexOf(uid);
+	if (row == -1)
+		return;
+	wModel.beginRemoveRows(QModelIndex(), row, row);
+	wModel.removeWeaponFromRow(row);
+	wModel.endRemoveRows();
 }
 
 WeaponModel::WeaponModel(QObject *parent)
@@ -507,35 +584,99 @@ WeaponModel::WeaponModel(QObject *parent)
 
 WeaponModel::~WeaponModel()
 {
-	qDeleteAll(weaponList);
+	clearModel();
+}
+
+void WeaponModel::clearModel()
+{
+	qDeleteAll(uidToWeapon);
+	uidToWeapon.clear();
+	unloadedWeapons.clear();
+	nameToUid.clear();
+	rowUids.clear();
+	catalog = nullptr;
 }
 
 void WeaponModel::addWeapon(int row, WeaponBase *weapon)
 {
-	weaponList.insert(row, weapon);
+	rowUids.insert(row, weapon->getUid());
 	uidToWeapon[weapon->getUid()] = weapon;
+	nameToUid.insert(weapon->getName(), weapon->getUid());
 }
 
 void WeaponModel::removeWeaponFromRow(int row)
 {
-	uidToWeapon.remove(weaponList[row]->getUid());
-	delete weaponList.takeAt(row);
+	UID uid = rowUids.takeAt(row);
+	nameToUid.remove(getName(uid), uid);
+	unloadedWeapons.remove(uid);
+	delete uidToWeapon.take(uid);
+}
+
+/**
+ * Returns the weapon of given UID, reading it from the catalog if it has not been read yet.
+ */
+/* static member */
+WeaponBase * WeaponModel::loadWeapon(UID uid)
+{
+	WeaponBase *weapon = uidToWeapon.value(uid, nullptr);
+	if (weapon != nullptr)
+		return weapon;
+
+	auto it = unloadedWeapons.find(uid);
+	if (it == unloadedWeapons.end() || catalog == nullptr)
+		return nullptr;
+
+	QDataStream in(catalog->read(*it));
+	weapon = new WeaponBase;
+	in >> *weapon;
+	unloadedWeapons.erase(it);
+	uidToWeapon[uid] = weapon;
+	return weapon;
+}
+
+/* static member */
+QString WeaponModel::getName(UID uid)
+{
+	const WeaponBase *weapon = uidToWeapon.value(uid, nullptr);
+	if (weapon != nullptr)
+		return weapon->getName();
+	return unloadedWeapons.value(uid).name;
+}
+
+/**
+ * Returns the UID of the weapon of given name. If several weapons share the name, the one in the last row is taken.
+ */
+/* static member */
+UID WeaponModel::findUid(const QString &name)
+{
+	const QList <UID> uids = nameToUid.values(name);
+	if (uids.size() == 1)
+		return uids.first();
+
+	UID result = uids.first();
+	int resultRow = rowUids.indexOf(result);
+	for (UID uid : uids) {
+		const int row = rowUids.indexOf(uid);
+		if (row > resultRow) {
+			result = uid;
+			resultRow = row;
+		}
+	}
+	return result;
 }
 
 QDataStream & operator << (QDataStream &out, const WeaponModel &wModel)
 {
-	out << wModel.nextUid << static_cast<UID>(wModel.weaponList.count());
-	for (const WeaponBase *weapon : wModel.weaponList)
-		out << *weapon;
+	out << wModel.nextUid << static_cast<UID>(wModel.rowUids.count());
+	for (UID uid : WeaponModel::rowUids)
+		out << *WeaponModel::loadWeapon(uid);
 	return out;
 }
 
 QDataStream & operator >> (QDataStream &in, WeaponModel &wModel)
 {
 	wModel.beginResetModel();
-	qDeleteAll(wModel.weaponList);
-	wModel.weaponList.clear();
-	wModel.uidToWeapon.clear();
+	wModel.clearModel();
 
 	UID count;
 	in >> wModel.nextUid >> count;
@@ -2,6 +2,7 @@
 #define WEAPON_BASE_H
 
 #include <QtWidgets>
+#include "BTCommon/CatalogFile.h"
 #include "BTCommon/CommonStrings.h"
 #include "BTCommon/EnumSerialization.h"
 #include "BTCommon/FileIO.h"
@@ -73,6 +74,7 @@ public:
 
 	friend QDebug & operator << (QDebug &out, const WeaponBase &weapon);
 
+	void setUid(UID uid);
 	UID getUid() const;
 
 private:
@@ -199,16 +201,22 @@ public:
 	static WeaponModel & getInstance();
 	static bool loadFromFile(const QString &fileName);
 	static bool saveToFile(const QString &fileName);
+	static void attachCatalog(const CatalogFile *catalog);
+	static UID getNextUid();
 
 	static void addNewWeapon();
 	static bool empty();
 	static const WeaponBase * getRow(int row);
+	static int getRowCount();
+	static UID getRowUid(int row);
+	static QString getRowName(int row);
 	static const WeaponBase * getWeapon(UID uid);
 	static const WeaponBase * getWeapon(const QModelIndex &index);
 	static const WeaponBase * getWeapon(const QString &name);
-	static const QList <WeaponBase *> & getWeapons();
+	static void loadAll();
 	static bool hasWeapon(const QString &name);
 	static void removeWeapon(UID uid);
+	static void importWeapons(const QList <WeaponBase *> &weapons);
 
 	static const int Name                 =  0;
 	static const int Type                 =  1;
@@ -236,15 +244,22 @@ private:
 	void operator=(WeaponModel &&) = delete;
 	~WeaponModel();
 
+	void clearModel();
 	void addWeapon(int row, WeaponBase *weapon);
 	void removeWeaponFromRow(int row);
+	static WeaponBase * loadWeapon(UID uid);
+	static QString getName(UID uid);
+	static UID findUid(const QString &name);
 
 	bool changed;
 	UID nextUid;
 
 	static const UID MinUid = 1;
-	static QList <WeaponBase *> weaponList;
-	static QHash <UID, WeaponBase *> uidToWeapon;
+	static QList <UID> rowUids;						/**< UIDs of the weapons, in the order of rows. */
+	static QHash <UID, WeaponBase *> uidToWeapon;				/**< Weapons read so far. */
+	static QHash <UID, CatalogFile::Entry> unloadedWeapons;			/**< Weapons still waiting in the catalog. */
+	static QMultiHash <QString, UID> nameToUid;				/**< Names need not be unique, so a name may index several weapons. */
+	static const CatalogFile *catalog;
 };
 
 #endif
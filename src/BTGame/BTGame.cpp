@@ -40,7 +40,7 @@ void BTGame::initCentralWindow()
 	connect(map, &GraphicsMap::mechActionsNeeded, this, &BTGame::setActionsInSideBar);
 	connect(map, &GraphicsMap::mechActionsNotNeeded, sideBar->getActionWindow(), &ActionWindow::clear);
 	connect(map, &GraphicsMap::messageSent, this, &BTGame::messageFromMapToSideBar);
-	connect(map, &GraphicsMap::extensiveInfoSent, this, &BTGame::onExtensiveInfo);
+	connect(map, &GraphicsMap::combatEventSent, logWindow, &LogWindow::printCombatEvent);
 
 	connect(sideBar, &SideBar::endMoveButtonPressed, map, &GraphicsMap::onEndMove);
 	connect(sideBar->getActionWindow(), &ActionWindow::actionActivated, map, &GraphicsMap::onChooseAction);
@@ -99,13 +99,11 @@ void BTGame::onTriggerLogWindow()
 	logWindow->setVisible(!logWindow->isVisible());
 }
 
-void BTGame::onLoadMapAction()
+void BTGame::onMapLoaded()
 {
-	BTMapManager::onLoadMapAction();
-	if (map->isLoaded()) {
-		menuStartGameAction->setEnabled(true);
-		menuSetVersion->setEnabled(true);
-	}
+	BTMapManager::onMapLoaded();
+	menuStartGameAction->setEnabled(true);
+	menuSetVersion->setEnabled(true);
 }
 
 void BTGame::onStartGameAction()
@@ -139,11 +137,6 @@ void BTGame::messageFromMapToSideBar()
 	sideBar->insertMessage(message.first, message.second);
 }
 
-void BTGame::onExtensiveInfo()
-{
-	logWindow->print(map->getExtInfo());
-}
-
 /**
  * \class GameVersionChoiceDialog
  */
@@ -61,14 +61,13 @@ private:
 
 private slots:
 	void onTriggerLogWindow();
-	void onLoadMapAction();
+	void onMapLoaded();
 	void onStartGameAction();
 	void onSetVersionAction();
 	void onEndGame();
 
 	void setActionsInSideBar();
 	void messageFromMapToSideBar();
-	void onExtensiveInfo();
 };
 
 /**
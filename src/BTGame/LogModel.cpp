@@ -0,0 +1,191 @@
+#include "BTCommon/Settings.h"
+#include "BTGame/LogModel.h"
+
+/**
+ * \class LogModel
+ */
+
+LogModel::LogModel(QObject *parent)
+	: QAbstractListModel(parent), first(0), count(0)
+{
+	capacity = qMax(1, Settings::value("game/logCapacity", DEFAULT_CAPACITY).toInt());
+	lines.resize(capacity);
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return count;
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() >= count)
+		return QVariant();
+
+	switch (role) {
+		case Qt::DisplayRole:
+		case Qt::ToolTipRole:    return lineAt(index.row()).text;
+		case Qt::ForegroundRole: return lineAt(index.row()).color;
+		default:                 return QVariant();
+	}
+}
+
+/**
+ * Splits text into lines. A fragment that does not end with a new line stays open,
+ * and the next printed text is appended to it.
+ */
+void LogModel::print(const QString &text, const QColor &color)
+{
+	QStringList fragments = text.split('\n');
+	for (int i = 0; i < fragments.size(); ++i) {
+		bool closed = (i < fragments.size() - 1);
+		QString fragment = fragments[i].replace('\t', "    ");
+		if (fragment.isEmpty() && !closed)
+			continue;
+
+		if (count > 0 && !lineAt(count - 1).closed) {
+			Line &last = lineAt(count - 1);
+			last.text += fragment;
+			last.closed = closed;
+			QModelIndex lastIndex = index(count - 1);
+			emit dataChanged(lastIndex, lastIndex);
+		} else {
+			appendLine(fragment, color, closed);
+		}
+	}
+}
+
+void LogModel::clear()
+{
+	beginResetModel();
+	first = 0;
+	count = 0;
+	endResetModel();
+}
+
+void LogModel::setCapacity(int capacity)
+{
+	capacity = qMax(1, capacity);
+
+	beginResetModel();
+	if (count > capacity) {
+		first = (first + count - capacity) % lines.size();
+		count = capacity;
+	}
+
+	QVector <Line> newLines(capacity);
+	for (int i = 0; i < count; ++i)
+		newLines[i] = lineAt(i);
+	lines.swap(newLines);
+	first = 0;
+	this->capacity = capacity;
+	endResetModel();
+}
+
+int LogModel::getCapacity() const
+{
+	return capacity;
+}
+
+LogModel::Line & LogModel::lineAt(int row)
+{
+	return lines[(first + row) % capacity];
+}
+
+const LogModel::Line & LogModel::lineAt(int row) const
+{
+	return lines[(first + row) % capacity];
+}
+
+void LogModel::appendLine(const QString &text, const QColor &color, bool closed)
+{
+	if (count == capacity) {
+		beginRemoveRows(QModelIndex(), 0, 0);
+		first = (first + 1) % capacity;
+		--count;
+		endRemoveRows();
+	}
+
+	beginInsertRows(QModelIndex(), count, count);
+	lineAt(count) = {text, color, closed};
+	++count;
+	endInsertRows();
+}
+
+/**
+ * \class LogDelegate
+ */
+
+LogDelegate::LogDelegate(QObject *parent)
+	: QStyledItemDelegate(parent)
+{}
+
+void LogDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+	painter->save();
+	painter->setFont(option.font);
+	painter->setPen(index.data(Qt::ForegroundRole).value<QColor>());
+	QString text = option.fontMetrics.elidedText(index.data().toString(), Qt::ElideRight, option.rect.width());
+	painter->drawText(option.rect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine, text);
+	painter->restore();
+}
+
+/**
+ * Shows the whole line in a tooltip, but only if it did not fit and was elided.
+ */
+bool LogDelegate::helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+	if (event->type() == QEvent::ToolTip && option.fontMetrics.width(index.data().toString()) <= option.rect.width()) {
+		QToolTip::hideText();
+		return true;
+	}
+	return QStyledItemDelegate::helpEvent(event, view, option, index);
+}
+
+QSize LogDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+	return QSize(option.fontMetrics.width(index.data().toString()), option.fontMetrics.height());
+}
+
+/**
+ * \class LogView
+ */
+
+LogView::LogView(QWidget *parent)
+	: QListView(parent)
+{
+	logModel = new LogModel(this);
+	setModel(logModel);
+	setItemDelegate(new LogDelegate(this));
+
+	setUniformItemSizes(true);
+	setLayoutMode(QListView::Batched);
+	setSelectionMode(QAbstractItemView::NoSelection);
+	setEditTriggers(QAbstractItemView::NoEditTriggers);
+	setFocusPolicy(Qt::NoFocus);
+	setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+	setBackgroundRole(QPalette::Window);
+	setPalette(QPalette(Qt::black));
+	setAutoFillBackground(true);
+	setMouseTracking(true);
+}
+
+LogModel * LogView::getLogModel() const
+{
+	return logModel;
+}
+
+void LogView::print(const QString &text, const QColor &color)
+{
+	bool atBottom = (verticalScrollBar()->value() == verticalScrollBar()->maximum());
+	logModel->print(text, color);
+	if (atBottom)
+		scrollToBottom();
+}
+
+void LogView::clear()
+{
+	logModel->clear();
+}
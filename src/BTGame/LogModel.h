@@ -0,0 +1,83 @@
+#ifndef LOG_MODEL_H
+#define LOG_MODEL_H
+
+#include <QtWidgets>
+
+/**
+ * \class LogModel
+ * Bounded list of coloured log lines. Lines are kept in a ring buffer, so appending costs the same
+ * regardless of how long the game lasts. Lines pushed out of the buffer are dropped.
+ */
+class LogModel : public QAbstractListModel
+{
+Q_OBJECT;
+
+public:
+	LogModel(QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+	void print(const QString &text, const QColor &color);
+	void clear();
+
+	void setCapacity(int capacity);
+	int getCapacity() const;
+
+	static const int DEFAULT_CAPACITY = 2000;
+
+private:
+	struct Line {
+		QString text;
+		QColor color;
+		bool closed;
+	};
+
+	QVector <Line> lines;							/**< Ring buffer of displayed lines. */
+	int first;								/**< Index of the oldest line in lines. */
+	int count;
+	int capacity;
+
+	Line & lineAt(int row);
+	const Line & lineAt(int row) const;
+	void appendLine(const QString &text, const QColor &color, bool closed);
+};
+
+/**
+ * \class LogDelegate
+ * Paints a single log line in its colour; every line has the same height, so views only lay out visible rows.
+ * Lines wider than the view are elided, the whole line being shown in a tooltip.
+ */
+class LogDelegate : public QStyledItemDelegate
+{
+Q_OBJECT;
+
+public:
+	LogDelegate(QObject *parent = nullptr);
+
+	void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+	QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+	bool helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &index);
+};
+
+/**
+ * \class LogView
+ * QListView set up for displaying a LogModel.
+ */
+class LogView : public QListView
+{
+Q_OBJECT;
+
+public:
+	LogView(QWidget *parent = nullptr);
+
+	LogModel * getLogModel() const;
+
+	void print(const QString &text, const QColor &color);
+	void clear();
+
+private:
+	LogModel *logModel;
+};
+
+#endif // LOG_MODEL_H
@@ -1,6 +1,4 @@
-#include "BTCommon/Colors.h"
 #include "BTGame/LogWindow.h"
-#include "BTGame/Strings.h"
 
 const QColor LogWindow::DefaultLogColor = Qt::white;
 
@@ -14,13 +12,7 @@ LogWindow::LogWindow(QWidget *parent)
 	setFeatures(QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable);
 	setMaximumWidth(MAX_WIDTH);
 
-	log = new QTextEdit(this);
-	log->setReadOnly(true);
-	log->setBackgroundRole(QPalette::Window);
-	log->setPalette(QPalette(Qt::black));
-	log->setAutoFillBackground(true);
-	log->setCursorWidth(0);
-	log->setMouseTracking(true);
+	log = new LogView(this);
 
 	QLayout *layout = new QVBoxLayout;
 	layout->addWidget(log);
@@ -32,23 +24,34 @@ LogWindow::LogWindow(QWidget *parent)
 
 void LogWindow::print(const QPair <QString, QColor> &msg)
 {
-	//TODO
-
-	for (int index = 0, length = 0; index + length < msg.first.length(); ++length) {
-		bool isEndLine = msg.first[index + length] == '\n';
-		if (isEndLine || (length == msg.first.length() - 1)) {
-			log->textCursor().insertHtml(BTech::HTML::FontColor
-			                             .arg(BTech::colorToString(msg.second))
-			                             .arg(msg.first.mid(index, length + int(!isEndLine))));
-			if (isEndLine)
-				log->textCursor().insertHtml(BTech::HTML::NewLine);
-			index += length + 1;
-			length = -1;
-		}
-	}
+	log->print(msg.first, msg.second);
 }
 
 void LogWindow::clear()
 {
 	log->clear();
+	pendingEvents.clear();
+}
+
+void LogWindow::printCombatEvent(const CombatEvent &event, const QColor &color)
+{
+	if (!isVisible()) {
+		pendingEvents.append({event, color});
+		if (pendingEvents.size() > log->getLogModel()->getCapacity()) {
+			QPair <CombatEvent, QColor> oldest = pendingEvents.takeFirst();
+			print({QString(oldest.first), oldest.second});
+		}
+		return;
+	}
+	print({QString(event), color});
+}
+
+void LogWindow::showEvent(QShowEvent *event)
+{
+	QDockWidget::showEvent(event);
+
+	QList <QPair <CombatEvent, QColor> > events;
+	events.swap(pendingEvents);
+	for (const QPair <CombatEvent, QColor> &pending : events)
+		print({QString(pending.first), pending.second});
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define LOG_WINDOW_H
 
 #include <QtWidgets>
+#include "BTCommon/CombatEvent.h"
+#include "BTGame/LogModel.h"
 
 class LogWindow : public QDockWidget
 {
@@ -13,11 +15,18 @@ public:
 	void print(const QPair <QString, QColor> &msg);
 	void clear();
 
+public slots:
+	void printCombatEvent(const CombatEvent &event, const QColor &color);
+
 private:
 	static const QColor DefaultLogColor;
 	static const int MAX_WIDTH;
 
-	QTextEdit *log;
+	LogView *log;
+
+	QList <QPair <CombatEvent, QColor> > pendingEvents;		/**< Events received while hidden, formatted on show. */
+
+	void showEvent(QShowEvent *event);
 };
 
-#endif // LOG_WINDOW_H
\ No newline at end of file
+#endif // LOG_WINDOW_H
@@ -299,9 +299,7 @@ void SideBar::disable()
 
 void SideBar::insertMessage(const QString &arg, const QColor &color)
 {
-	logWindow->setTextColor(color);
-	log << arg;
-	logWindow->append(arg);
+	logWindow->print(arg + '\n', color);
 }
 
 void SideBar::initWindow()
@@ -334,14 +332,7 @@ void SideBar::initActionWindow()
 
 void SideBar::initLogWindow()
 {
-	logWindow = new QTextEdit(this);
-	logWindow->setReadOnly(true);
-	logWindow->setBackgroundRole(QPalette::Window);
-	logWindow->setPalette(QPalette(Qt::black));
-	logWindow->setAutoFillBackground(true);
-	logWindow->setTextColor(Qt::green);
-	logWindow->setCursorWidth(0);
-	logWindow->setMouseTracking(true);
+	logWindow = new LogView(this);
 	logWindow->setBaseSize(300, 200);
 }
 
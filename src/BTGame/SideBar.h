@@ -3,6 +3,7 @@
 
 #include <QtWidgets>
 #include "BTCommon/MechEntity.h"
+#include "BTGame/LogModel.h"
 #include "BTGame/Strings.h"
 
 /**
@@ -121,12 +122,11 @@ private:
 	static const int MIN_HEIGHT = 600;
 
 	QImage *image;
-	QVector <QString> log;
 
 	QVBoxLayout *layout;
 	QLabel *imageWindow;
 	ActionWindow *actionWindow;
-	QTextEdit *logWindow;
+	LogView *logWindow;
 	QPushButton *endMoveButton;
 
 	void initWindow();
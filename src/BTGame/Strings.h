@@ -13,11 +13,6 @@ namespace BTech {
 
 		const QString ButtonConfirm = QObject::tr("Confirm");
 	}
-
-	namespace HTML {
-		const QString FontColor = QObject::tr("<FONT COLOR=%1>%2</FONT>");
-		const QString NewLine   = QObject::tr("<br>");
-	}
 }
 
 #endif // BTGAME_STRINGS_H
\ No newline at end of file
@@ -1,4 +1,6 @@
+#include "BTCommon/CatalogImporter.h"
 #include "BTCommon/DataManager.h"
+#include "BTCommon/FileWriter.h"
 #include "BTCommon/Paths.h"
 #include "BTCommon/Settings.h"
 #include "BTMapEditor/BTMapEditor.h"
@@ -54,6 +56,7 @@ void BTMapEditor::initMenu()
 	menuEditWeaponsAction = new QAction(this);
 	menuEditMechsAction   = new QAction(this);
 	menuSaveDataAction    = new QAction(this);
+	menuImportDataAction  = new QAction(this);
 
 	menuNewMapAction->setText(BTech::Strings::MenuActionNewMap);
 	menuSaveMapAction->setText(BTech::Strings::MenuActionSaveMap);
@@ -61,6 +64,7 @@ void BTMapEditor::initMenu()
 	menuEditWeaponsAction->setText(BTech::Strings::MenuActionEditWeapons);
 	menuEditMechsAction->setText(BTech::Strings::MenuActionEditMechs);
 	menuSaveDataAction->setText(BTech::Strings::MenuActionSaveData);
+	menuImportDataAction->setText(BTech::Strings::MenuActionImportData);
 
 	menuNewMapAction->setShortcut(QKeySequence::New);
 	menuSaveMapAction->setShortcut(QKeySequence::Save);
@@ -72,6 +76,7 @@ void BTMapEditor::initMenu()
 	connect(menuEditWeaponsAction, &QAction::triggered, this, &BTMapEditor::onEditWeaponsAction);
 	connect(menuEditMechsAction,   &QAction::triggered, this, &BTMapEditor::onEditMechsAction);
 	connect(menuSaveDataAction,    &QAction::triggered, this, &BTMapEditor::onSaveData);
+	connect(menuImportDataAction,  &QAction::triggered, this, &BTMapEditor::onImportDataAction);
 
 	fileMenu->addAction(menuNewMapAction);
 	fileMenu->addAction(menuSaveMapAction);
@@ -80,6 +85,7 @@ void BTMapEditor::initMenu()
 	editMenu->addAction(menuEditWeaponsAction);
 	editMenu->addAction(menuEditMechsAction);
 	editMenu->addAction(menuSaveDataAction);
+	editMenu->addAction(menuImportDataAction);
 
 	sortMenu();
 }
@@ -101,6 +107,8 @@ void BTMapEditor::initSystem()
 	currentPlayer = nullptr;
 	currentTerrain = BTech::Terrain::Clear;
 	clickModeActive = false;
+
+	connect(&FileWriter::getInstance(), &FileWriter::written, this, &BTMapEditor::onFileWritten);
 }
 
 void BTMapEditor::readSettings()
@@ -114,18 +122,22 @@ void BTMapEditor::writeSettings()
 	Settings::sync();
 }
 
+/**
+ * Serializes the map and leaves writing it to the FileWriter, so the editor stays interactive.
+ */
 bool BTMapEditor::saveMap(const QString &path)
 {
 	if (path.size() == 0)
 		return false;
-	QFile file(path);
-	if (!file.open(QIODevice::WriteOnly))
-		return false;
-	QDataStream out(&file);
 	map->setMapFileName(path);
+
+	QByteArray data;
+	QDataStream out(&data, QIODevice::WriteOnly);
 	out << *map;
-	file.close();
+	if (out.status() != QDataStream::Ok)
+		return false;
 
+	FileWriter::write(path, data);
 	return true;
 }
 
@@ -137,10 +149,8 @@ void BTMapEditor::reloadData()
 void BTMapEditor::onNewMapAction()
 {
 	NewMapDialog dialog(this);
-	if (dialog.exec()) {
+	if (dialog.exec())
 		map->createNewMap(dialog.getMapWidth(), dialog.getMapHeight());
-		BTMapManager::startMapManagement();
-	}
 }
 
 void BTMapEditor::onSaveMapAction()
@@ -198,7 +208,40 @@ void BTMapEditor::onSaveData()
 	if (!DataManager::saveToFile(BTech::Paths::DATA_PATH))
 		qWarning() << "Save data failed!";
 	else
-		qDebug() << "Data saved.";
+		qDebug() << "Saving data...";
+}
+
+void BTMapEditor::onImportDataAction()
+{
+	QString path = QFileDialog::getOpenFileName(this, BTech::Strings::DialogImportData, QString(), BTech::Strings::DialogCatalogFiles);
+	if (path.isEmpty())
+		return;
+
+	CatalogImporter importer;
+	if (!importer.importFile(path)) {
+		QMessageBox::warning(this, BTech::Strings::DialogImportData, BTech::Strings::ImportDataFailed);
+		return;
+	}
+	reloadData();
+
+	QMessageBox dialog(QMessageBox::Information,
+	                   BTech::Strings::DialogImportData,
+	                   BTech::Strings::ImportDataSummary.arg(importer.getImportedWeapons()).arg(importer.getImportedMechs()),
+	                   QMessageBox::Ok,
+	                   this);
+	if (!importer.getErrors().isEmpty()) {
+		dialog.setInformativeText(BTech::Strings::ImportDataErrors.arg(importer.getErrors().size()));
+		dialog.setDetailedText(importer.getErrors().join('\n'));
+	}
+	dialog.exec();
+}
+
+void BTMapEditor::onFileWritten(const QString &fileName, bool success)
+{
+	if (!success)
+		qWarning() << "Writing" << fileName << "failed!";
+	else
+		qDebug() << fileName << "saved.";
 }
 
 void BTMapEditor::onChoosePlayer(Player *player)
@@ -237,6 +280,7 @@ void BTMapEditor::onHexClicked(Hex *hex)
 			break; // responsibility for the new allocated MechEntity goes to GraphicsMap.
 		case Chosen::Terrain:
 			hex->setTerrain(currentTerrain);
+			map->updateHexTerrain(hex);
 			break;
 		default:;
 	}
@@ -249,5 +293,7 @@ void BTMapEditor::updatePlayers()
 
 void BTMapEditor::updateHexes()
 {
+	if (map->getCurrentHex() != nullptr)
+		map->updateHexTerrain(map->getCurrentHex());
 	map->updateHexes();
 }
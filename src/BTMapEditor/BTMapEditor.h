@@ -29,6 +29,7 @@ private:
 	QAction *menuEditWeaponsAction;
 	QAction *menuEditMechsAction;
 	QAction *menuSaveDataAction;
+	QAction *menuImportDataAction;
 
 	ToolBar *toolBar;
 
@@ -67,6 +68,8 @@ private slots:
 	void onEditWeaponsAction();
 	void onEditMechsAction();
 	void onSaveData();
+	void onImportDataAction();
+	void onFileWritten(const QString &fileName, bool success);
 
 	void onChoosePlayer(Player *player);
 	void onChooseUnit(UID unitUid);
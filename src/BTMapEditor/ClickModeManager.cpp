@@ -146,8 +146,8 @@ void ClickModeManager::initBoxes()
 	unitTypeComboBox = new QComboBox;
 	unitTypeComboBox->setFixedWidth(150);
 	unitTypeComboBox->setEnabled(false);
-	for (const MechBase *mech : MechModel::getMechs())
-		unitTypeComboBox->addItem(static_cast<QString>(*mech));
+	for (int row = 0; row < MechModel::getRowCount(); ++row)
+		unitTypeComboBox->addItem(MechModel::getRowType(row));
 	connect(unitTypeComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::activated), this, &ClickModeManager::onMechTypeSelected);
 }
 
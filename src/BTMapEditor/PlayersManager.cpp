@@ -114,9 +114,9 @@ void PlayersManager::addNewPlayer()
 	if (players.size() == MAX_PLAYERS_SIZE)
 		return;
 
-	QList <QString> existingNames;
+	QSet <QString> existingNames;
 	for (Player *player : players)
-		existingNames.append(player->getName());
+		existingNames.insert(player->getName());
 	QString newName = BTech::General::indexString(BTech::Strings::UnnamedPlayer, existingNames);
 
 	Player *player = new Player;
@@ -13,9 +13,12 @@ namespace BTech {
 		const QString MenuActionEditWeapons = QObject::tr("Edit &weapons");
 		const QString MenuActionEditMechs   = QObject::tr("Edit &mechs");
 		const QString MenuActionSaveData    = QObject::tr("Save &data");
+		const QString MenuActionImportData  = QObject::tr("&Import data");
 
 		const QString DialogSaveMap           = QObject::tr("Save map");
 		const QString DialogQuitWithoutSaving = QObject::tr("Quit message");
+		const QString DialogImportData        = QObject::tr("Import data");
+		const QString DialogCatalogFiles      = QObject::tr("Catalog files (*.csv *.json)");
 
 		const QString ButtonOk                    = QObject::tr("&Ok");
 		const QString ButtonConfirm               = QObject::tr("Con&firm");
@@ -76,6 +79,9 @@ namespace BTech {
 		const QString LabelPlayers             = QObject::tr("Players");
 		const QString LabelMap                 = QObject::tr("Map");
 
+		const QString SearchWeapons = QObject::tr("Search, e.g. laser type:energy tonnage<=5 range>=9");
+		const QString SearchMechs   = QObject::tr("Search, e.g. atlas tonnage>=80 range>=5");
+
 		const QString UnnamedMech   = QObject::tr("Unnamed Mech");
 		const QString UnnamedWeapon = QObject::tr("Unnamed Weapon");
 		const QString UnnamedPlayer = QObject::tr("UnnamedPlayer");
@@ -94,6 +100,10 @@ namespace BTech {
 		const QString GameVersionDialogWarning = QObject::tr("At least one version must be checked.");
 
 		const QString QuitWithoutSavingWarning = QObject::tr("Data has been changed. Do you want to save it?");
+
+		const QString ImportDataFailed  = QObject::tr("The file could not be read.");
+		const QString ImportDataSummary = QObject::tr("Imported %1 weapons and %2 mechs.");
+		const QString ImportDataErrors  = QObject::tr("%1 records were skipped.");
 	}
 
 	namespace Paths {
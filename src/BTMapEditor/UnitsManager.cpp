@@ -48,8 +48,8 @@ void UnitsManager::initMechList()
 	QString mechName;
 	mechListLayout = new QVBoxLayout;
 	mechListLayout->setAlignment(Qt::AlignTop);
-	for (MechBase *mech : MechModel::getMechs()) {
-		mechName = static_cast<QString>(*mech);
+	for (int row = 0; row < MechModel::getRowCount(); ++row) {
+		mechName = MechModel::getRowType(row);
 		if (mechName.length() > 0) {
 			//TODO change this ugly stupid label to the mech icon
 			ClickableLabel *label = new ClickableLabel(mechName);
@@ -0,0 +1,252 @@
+#include "BTCommon/EnumHashFunctions.h"
+#include "BTCommon/MechBase.h"
+#include "BTCommon/WeaponBase.h"
+#include "BTMapEditor/dialogs/CatalogFilterModel.h"
+
+/**
+ * \class CatalogFilterModel
+ */
+
+CatalogFilterModel::CatalogFilterModel(QAbstractItemModel *sourceModel, QObject *parent)
+	: QSortFilterProxyModel(parent), acceptedRowsValid(false)
+{
+	setSourceModel(sourceModel);
+	setDynamicSortFilter(true);
+
+	connect(sourceModel, &QAbstractItemModel::dataChanged,   this, &CatalogFilterModel::invalidateAcceptedRows);
+	connect(sourceModel, &QAbstractItemModel::layoutChanged, this, &CatalogFilterModel::invalidateAcceptedRows);
+	connect(sourceModel, &QAbstractItemModel::modelReset,    this, &CatalogFilterModel::invalidateAcceptedRows);
+	connect(sourceModel, &QAbstractItemModel::rowsInserted,  this, &CatalogFilterModel::invalidateAcceptedRows);
+	connect(sourceModel, &QAbstractItemModel::rowsMoved,     this, &CatalogFilterModel::invalidateAcceptedRows);
+	connect(sourceModel, &QAbstractItemModel::rowsRemoved,   this, &CatalogFilterModel::invalidateAcceptedRows);
+}
+
+void CatalogFilterModel::addTextColumn(const QString &key, int column, const TextConverter &converter)
+{
+	columns[key] = {column, false, converter};
+	terms = parse(filterText);
+	invalidateAcceptedRows();
+	invalidateFilter();
+}
+
+void CatalogFilterModel::addNumberColumn(const QString &key, int column)
+{
+	columns[key] = {column, true, TextConverter()};
+	terms = parse(filterText);
+	invalidateAcceptedRows();
+	invalidateFilter();
+}
+
+QString CatalogFilterModel::getFilterText() const
+{
+	return filterText;
+}
+
+/**
+ * Filter of WeaponModel by name, type, tonnage and long range.
+ */
+/* static */
+CatalogFilterModel * CatalogFilterModel::createWeaponFilter(QObject *parent)
+{
+	CatalogFilterModel *filter = new CatalogFilterModel(&WeaponModel::getInstance(), parent);
+	filter->addTextColumn("name", WeaponModel::Name);
+	filter->addTextColumn("type", WeaponModel::Type, [](const QVariant &type) {
+		return BTech::weaponTypeStringChange[static_cast<BTech::WeaponType>(type.toInt())];
+	});
+	filter->addNumberColumn("tonnage", WeaponModel::Tonnage);
+	filter->addNumberColumn("range",   WeaponModel::MaximalLongRange);
+	return filter;
+}
+
+/**
+ * Filter of MechModel by type, tonnage and base fire range.
+ */
+/* static */
+CatalogFilterModel * CatalogFilterModel::createMechFilter(QObject *parent)
+{
+	CatalogFilterModel *filter = new CatalogFilterModel(&MechModel::getInstance(), parent);
+	filter->addTextColumn("name", MechModel::Mech::Type);
+	filter->addNumberColumn("tonnage", MechModel::Mech::Tonnage);
+	filter->addNumberColumn("range",   MechModel::Mech::BaseFireRange);
+	return filter;
+}
+
+/**
+ * Maps index of any chain of proxy models to the index of the model at its bottom.
+ */
+/* static */
+QModelIndex CatalogFilterModel::mapToBase(const QModelIndex &index)
+{
+	QModelIndex result = index;
+	while (const QAbstractProxyModel *proxy = qobject_cast<const QAbstractProxyModel *>(result.model()))
+		result = proxy->mapToSource(result);
+	return result;
+}
+
+void CatalogFilterModel::setFilterText(const QString &text)
+{
+	if (text == filterText)
+		return;
+
+	QList <Term> newTerms = parse(text);
+	const int rowCount = sourceModel()->rowCount();
+	if (acceptedRowsValid && acceptedRows.size() == rowCount && narrows(newTerms))
+		previouslyAcceptedRows = acceptedRows;
+
+	filterText = text;
+	terms = newTerms;
+	acceptedRows.fill(false, rowCount);
+	evaluatedRows.fill(false, rowCount);
+
+	invalidateFilter();
+
+	// rows of parents which are not mapped yet are not filtered at all, so the result is complete only if every row was seen
+	acceptedRowsValid = (evaluatedRows.count(true) == rowCount);
+	previouslyAcceptedRows.clear();
+}
+
+bool CatalogFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+	if (sourceParent.isValid())
+		return true;
+
+	const bool inRange = sourceRow < acceptedRows.size();
+	if (inRange)
+		evaluatedRows.setBit(sourceRow);
+
+	if (!previouslyAcceptedRows.isEmpty() && !previouslyAcceptedRows.testBit(sourceRow))
+		return false;
+
+	bool accepted = true;
+	for (const Term &term : terms) {
+		if (!matches(term, sourceRow)) {
+			accepted = false;
+			break;
+		}
+	}
+
+	if (inRange)
+		acceptedRows.setBit(sourceRow, accepted);
+	return accepted;
+}
+
+/**
+ * Returns true if every row matching this term also matches given one.
+ */
+bool CatalogFilterModel::Term::narrows(const Term &term) const
+{
+	if (term.word.isEmpty())
+		return true;
+	if (column != term.column || op != term.op)
+		return false;
+	if (op == Operator::Contains)
+		return word.contains(term.word, Qt::CaseInsensitive);
+	return !word.isEmpty() && number == term.number;
+}
+
+QList <CatalogFilterModel::Term> CatalogFilterModel::parse(const QString &text) const
+{
+	static const QRegularExpression keyTerm("^(\\w+)(<=|>=|<|>|=|:)(.*)$");
+	static const QHash <QString, Operator> operators = {
+		{ "<",  Operator::Less           },
+		{ "<=", Operator::LessOrEqual    },
+		{ "=",  Operator::Equal          },
+		{ ":",  Operator::Equal          },
+		{ ">=", Operator::GreaterOrEqual },
+		{ ">",  Operator::Greater        },
+	};
+
+	QList <Term> result;
+	for (const QString &part : text.split(' ', QString::SkipEmptyParts)) {
+		Term term = {nullptr, Operator::Contains, part, 0};
+
+		QRegularExpressionMatch match = keyTerm.match(part);
+		auto it = columns.constFind(match.captured(1).toLower());
+		if (match.hasMatch() && it != columns.constEnd()) {
+			const QString op = match.captured(2);
+			const QString value = match.captured(3);
+			if (!it->isNumber && (op == ":" || op == "=")) {
+				term = {&*it, Operator::Contains, value, 0};
+			} else if (it->isNumber) {
+				bool ok;
+				int number = value.toInt(&ok);
+				term = {&*it, operators[op], ok ? value : QString(), number};
+			}
+		}
+
+		result.append(term);
+	}
+	return result;
+}
+
+/**
+ * Returns true if rows matching given terms are a subset of rows matching the current ones.
+ */
+bool CatalogFilterModel::narrows(const QList <Term> &newTerms) const
+{
+	if (newTerms.size() < terms.size())
+		return false;
+	for (int i = 0; i < terms.size(); ++i)
+		if (!newTerms[i].narrows(terms[i]))
+			return false;
+	return true;
+}
+
+bool CatalogFilterModel::matches(const Term &term, int sourceRow) const
+{
+	if (term.word.isEmpty())
+		return true;
+
+	if (term.column == nullptr) {
+		for (const Column &column : columns)
+			if (!column.isNumber && getText(column, sourceRow).contains(term.word, Qt::CaseInsensitive))
+				return true;
+		return false;
+	}
+
+	if (!term.column->isNumber)
+		return getText(*term.column, sourceRow).contains(term.word, Qt::CaseInsensitive);
+
+	const int value = sourceModel()->index(sourceRow, term.column->column, QModelIndex()).data().toInt();
+	switch (term.op) {
+		case Operator::Less:           return value <  term.number;
+		case Operator::LessOrEqual:    return value <= term.number;
+		case Operator::Equal:          return value == term.number;
+		case Operator::GreaterOrEqual: return value >= term.number;
+		case Operator::Greater:        return value >  term.number;
+		default:                       return true;
+	}
+}
+
+QString CatalogFilterModel::getText(const Column &column, int sourceRow) const
+{
+	QVariant value = sourceModel()->index(sourceRow, column.column, QModelIndex()).data();
+	return column.converter ? column.converter(value) : value.toString();
+}
+
+void CatalogFilterModel::invalidateAcceptedRows()
+{
+	acceptedRowsValid = false;
+}
+
+/**
+ * \class CatalogSearchEdit
+ */
+
+CatalogSearchEdit::CatalogSearchEdit(CatalogFilterModel *model, QWidget *parent)
+	: QLineEdit(parent), model(model)
+{
+	setClearButtonEnabled(true);
+
+	timer = new QTimer(this);
+	timer->setSingleShot(true);
+	timer->setInterval(FILTER_DELAY_MS);
+
+	connect(this,  &QLineEdit::textChanged, timer, static_cast<void (QTimer::*)()>(&QTimer::start));
+	connect(timer, &QTimer::timeout,        this,  &CatalogSearchEdit::applyFilter);
+}
+
+void CatalogSearchEdit::applyFilter()
+{
+	model->setFilterText(text().simplified());
+}
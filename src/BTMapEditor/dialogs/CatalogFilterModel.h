@@ -0,0 +1,116 @@
+#ifndef CATALOG_FILTER_MODEL_H
+#define CATALOG_FILTER_MODEL_H
+
+#include <QtWidgets>
+#include <functional>
+
+/**
+ * \class CatalogFilterModel
+ * Filters top-level rows of WeaponModel or MechModel by a search text; rows below them are always accepted.
+ *
+ * The text is split into terms which all have to match:
+ * - a plain word matches rows having it in any text column, case insensitive,
+ * - "key:word" or "key=word" matches rows having the word in the text column registered as key,
+ * - "key<n", "key<=n", "key=n", "key>=n", "key>n" compares the number column registered as key with n.
+ * Unfinished terms, like "tonnage>", match everything, so the view does not flicker while typing.
+ *
+ * When the new text only narrows the previous one (e.g. a word got longer or a term was appended),
+ * rows rejected by the previous text are rejected again without reading their data.
+ */
+class CatalogFilterModel : public QSortFilterProxyModel
+{
+Q_OBJECT;
+
+public:
+	typedef std::function<QString (const QVariant &)> TextConverter;
+
+	CatalogFilterModel(QAbstractItemModel *sourceModel, QObject *parent = nullptr);
+
+	void addTextColumn(const QString &key, int column, const TextConverter &converter = TextConverter());
+	void addNumberColumn(const QString &key, int column);
+
+	QString getFilterText() const;
+
+	static CatalogFilterModel * createWeaponFilter(QObject *parent);
+	static CatalogFilterModel * createMechFilter(QObject *parent);
+	static QModelIndex mapToBase(const QModelIndex &index);
+
+public slots:
+	void setFilterText(const QString &text);
+
+protected:
+	bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
+
+private:
+	enum class Operator : quint8 {
+		Contains,
+		Less,
+		LessOrEqual,
+		Equal,
+		GreaterOrEqual,
+		Greater
+	};
+
+	/**
+	 * \struct Column
+	 */
+	struct Column {
+		int column;
+		bool isNumber;
+		TextConverter converter;
+	};
+
+	/**
+	 * \struct Term
+	 * A word with no column (column == nullptr) is looked for in all text columns.
+	 * Terms with an empty word match everything.
+	 */
+	struct Term {
+		const Column *column;
+		Operator op;
+		QString word;
+		int number;
+
+		bool narrows(const Term &term) const;
+	};
+
+	QString filterText;
+	QList <Term> terms;
+	QHash <QString, Column> columns;
+
+	mutable QBitArray acceptedRows;						/**< Rows accepted by the current text. */
+	mutable QBitArray evaluatedRows;					/**< Rows checked since the text was last set. */
+	bool acceptedRowsValid;
+	QBitArray previouslyAcceptedRows;					/**< Rows accepted by the previous text, set only while refiltering. */
+
+	QList <Term> parse(const QString &text) const;
+	bool narrows(const QList <Term> &newTerms) const;
+	bool matches(const Term &term, int sourceRow) const;
+	QString getText(const Column &column, int sourceRow) const;
+
+private slots:
+	void invalidateAcceptedRows();
+};
+
+/**
+ * \class CatalogSearchEdit
+ * Line edit passing its text to a CatalogFilterModel once the user stops typing for a moment.
+ */
+class CatalogSearchEdit : public QLineEdit
+{
+Q_OBJECT;
+
+public:
+	CatalogSearchEdit(CatalogFilterModel *model, QWidget *parent = nullptr);
+
+private:
+	CatalogFilterModel *model;
+	QTimer *timer;
+
+	static const int FILTER_DELAY_MS = 150;					/**< Time after the last key press before the view is filtered. */
+
+private slots:
+	void applyFilter();
+};
+
+#endif // CATALOG_FILTER_MODEL_H
@@ -20,11 +20,6 @@ void EditMechPartsWidget::setCurrentIndex(const QModelIndex &index)
 	attachedWeapons->setRootIndex(index);
 }
 
-void EditMechPartsWidget::setModel(QAbstractItemModel *model)
-{
-	attachedWeapons->setModel(model);
-}
-
 void EditMechPartsWidget::initBoxes()
 {
 	maxArmorValue = new QSpinBox;
@@ -58,11 +53,16 @@ void EditMechPartsWidget::initListView()
 	attachedWeapons->setSelectionBehavior(QAbstractItemView::SelectRows);
 	attachedWeapons->setSelectionMode(QAbstractItemView::ExtendedSelection);
 
+	allWeaponsFilter = CatalogFilterModel::createWeaponFilter(this);
+	searchEdit = new CatalogSearchEdit(allWeaponsFilter);
+	searchEdit->setPlaceholderText(BTech::Strings::SearchWeapons);
+
 	allWeapons = new QListView;
-	allWeapons->setModel(&WeaponModel::getInstance());
+	allWeapons->setModel(allWeaponsFilter);
 	allWeapons->setModelColumn(WeaponModel::Name);
 	allWeapons->setSelectionBehavior(QAbstractItemView::SelectRows);
 	allWeapons->setSelectionMode(QAbstractItemView::SingleSelection);	// TODO DON'T LIKE IT
+	allWeapons->setUniformItemSizes(true);
 }
 
 void EditMechPartsWidget::initLayout()
@@ -87,6 +87,7 @@ void EditMechPartsWidget::initLayout()
 
 	QVBoxLayout *allWeaponsLayout = new QVBoxLayout;
 	allWeaponsLayout->addWidget(new QLabel(BTech::Strings::LabelAvailableWeapons));
+	allWeaponsLayout->addWidget(searchEdit);
 	allWeaponsLayout->addWidget(allWeapons);
 
 	QHBoxLayout *layout = new QHBoxLayout;
@@ -120,7 +121,7 @@ QList <int> EditMechPartsWidget::getSelectedIndexes() const
 void EditMechPartsWidget::addWeapons()
 {
 	for (const QModelIndex &index : allWeapons->selectionModel()->selectedRows())
-		MechModel::addWeaponToMechPart(currentIndex(), WeaponModel::getWeapon(index));
+		MechModel::addWeaponToMechPart(currentIndex(), WeaponModel::getWeapon(allWeaponsFilter->mapToSource(index)));
 }
 
 void EditMechPartsWidget::removeWeapons()
@@ -3,6 +3,7 @@
 
 #include <QtWidgets>
 #include "BTMapEditor/dialogs/AbstractEditMechsWidget.h"
+#include "BTMapEditor/dialogs/CatalogFilterModel.h"
 #include "BTMapEditor/dialogs/ItemComboBox.h"
 
 /**
@@ -17,7 +18,6 @@ public:
 	EditMechPartsWidget(QAbstractItemView *view);
 
 	void setCurrentIndex(const QModelIndex &index);
-	void setModel(QAbstractItemModel *model);
 
 private:
 	QSpinBox *maxArmorValue;
@@ -32,6 +32,8 @@ private:
 
 	QListView *attachedWeapons;
 	QListView *allWeapons;
+	CatalogFilterModel *allWeaponsFilter;
+	CatalogSearchEdit *searchEdit;
 
 	void initBoxes();
 	void initButtons();
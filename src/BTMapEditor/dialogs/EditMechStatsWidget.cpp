@@ -1,4 +1,5 @@
 #include "BTCommon/EnumHashFunctions.h"
+#include "BTMapEditor/dialogs/CatalogFilterModel.h"
 #include "BTMapEditor/dialogs/EditMechStatsWidget.h"
 
 /**
@@ -102,6 +103,6 @@ void EditMechStatsWidget::initWidgetMapping()
 
 void EditMechStatsWidget::removeMech()
 {
-	const MechBase *mech = MechModel::getRow(view->selectionModel()->currentIndex().row());
+	const MechBase *mech = MechModel::getRow(CatalogFilterModel::mapToBase(view->selectionModel()->currentIndex()).row());
 	MechModel::removeMech(mech->getUid());
 }
\ No newline at end of file
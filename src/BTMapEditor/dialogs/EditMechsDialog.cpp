@@ -7,10 +7,10 @@ static const int StatusBarMessageTimeoutMs = 5000;
  * \class MechTreeProxyModel
  */
 
-MechTreeProxyModel::MechTreeProxyModel(QObject *parent)
+MechTreeProxyModel::MechTreeProxyModel(QAbstractItemModel *sourceModel, QObject *parent)
 	: QIdentityProxyModel(parent)
 {
-	setSourceModel(&MechModel::getInstance());
+	setSourceModel(sourceModel);
 }
 
 int MechTreeProxyModel::columnCount(const QModelIndex &parent) const
@@ -47,11 +47,17 @@ EditMechsDialog::EditMechsDialog(QWidget *parent)
 
 void EditMechsDialog::initWidgets()
 {
-	MechTreeProxyModel *proxyModel = new MechTreeProxyModel(this);
+	mechFilter = CatalogFilterModel::createMechFilter(this);
+
+	searchEdit = new CatalogSearchEdit(mechFilter, this);
+	searchEdit->setPlaceholderText(BTech::Strings::SearchMechs);
+
+	MechTreeProxyModel *proxyModel = new MechTreeProxyModel(mechFilter, this);
 	view = new QTreeView(this);
 	view->setModel(proxyModel);
 	view->setHeaderHidden(true);
 	view->setSelectionMode(QAbstractItemView::SingleSelection);
+	view->setUniformRowHeights(true);
 	connect(view->selectionModel(), &QItemSelectionModel::selectionChanged, this, &EditMechsDialog::adjustStackedWidget);
 
 	statusBar = new QStatusBar;
@@ -59,7 +65,6 @@ void EditMechsDialog::initWidgets()
 	topLevelPlaceholder = new AbstractEditMechsWidget();
 	editMechStatsWidget = new EditMechStatsWidget(view, statusBar);
 	editMechPartsWidget = new EditMechPartsWidget(view);
-	editMechPartsWidget->setModel(proxyModel);
 	editWeaponsWidget = new EditWeaponsWidget(view);
 
 	stackedWidget = new QStackedWidget(this);
@@ -87,8 +92,12 @@ void EditMechsDialog::initLayout()
 {
 	// TODO later
 
+	QVBoxLayout *viewLayout = new QVBoxLayout;
+	viewLayout->addWidget(searchEdit);
+	viewLayout->addWidget(view);
+
 	QHBoxLayout *upperPartLayout = new QHBoxLayout;
-	upperPartLayout->addWidget(view);
+	upperPartLayout->addLayout(viewLayout);
 	upperPartLayout->addWidget(stackedWidget);
 
 	statusBar->setSizeGripEnabled(false);
@@ -109,7 +118,7 @@ void EditMechsDialog::addMech()
 
 void EditMechsDialog::removeMech()
 {
-	QModelIndex index = view->selectionModel()->currentIndex();
+	QModelIndex index = CatalogFilterModel::mapToBase(view->selectionModel()->currentIndex());
 
 	if (MechModel::getIndexType(index) == MechModel::Level::Root)
 		return;
@@ -137,7 +146,8 @@ void EditMechsDialog::discard()
 
 void EditMechsDialog::adjustStackedWidget()
 {
-	QModelIndex index = view->selectionModel()->currentIndex();
+	// the widgets edit MechModel itself, not the filtered view of it
+	QModelIndex index = CatalogFilterModel::mapToBase(view->selectionModel()->currentIndex());
 // 	qDebug() << __PRETTY_FUNCTION__ << index << view->selectionModel() << view->model();
 	AbstractEditMechsWidget *currentWidget = *levelToWidget[MechModel::getIndexType(index)];
 
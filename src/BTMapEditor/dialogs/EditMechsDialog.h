@@ -4,6 +4,7 @@
 #include <QtWidgets>
 #include "BTCommon/MechBase.h"
 #include "BTMapEditor/dialogs/AbstractEditMechsWidget.h"
+#include "BTMapEditor/dialogs/CatalogFilterModel.h"
 #include "BTMapEditor/dialogs/EditMechPartsWidget.h"
 #include "BTMapEditor/dialogs/EditMechStatsWidget.h"
 #include "BTMapEditor/dialogs/EditWeaponsWidget.h"
@@ -16,7 +17,7 @@
 class MechTreeProxyModel : public QIdentityProxyModel
 {
 public:
-	MechTreeProxyModel(QObject *parent = nullptr);
+	MechTreeProxyModel(QAbstractItemModel *sourceModel, QObject *parent = nullptr);
 
 	int columnCount(const QModelIndex &parent) const;
 	QVariant data(const QModelIndex &index, int role) const;
@@ -55,6 +56,8 @@ private:
 
 	QStatusBar *statusBar;
 
+	CatalogFilterModel *mechFilter;
+	CatalogSearchEdit *searchEdit;
 	QTreeView *view;
 
 	static const int ROOT_WIDGET            = 0;
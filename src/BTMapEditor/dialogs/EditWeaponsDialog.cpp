@@ -130,13 +130,20 @@ void EditWeaponsDialog::initLayoutEditPart(QBoxLayout* layout)
 
 void EditWeaponsDialog::initLayoutViewPart(QBoxLayout* layout)
 {
+	weaponFilter = CatalogFilterModel::createWeaponFilter(this);
+
+	searchEdit = new CatalogSearchEdit(weaponFilter);
+	searchEdit->setPlaceholderText(BTech::Strings::SearchWeapons);
+
 	weaponList = new QListView;
-	weaponList->setModel(&WeaponModel::getInstance());
+	weaponList->setModel(weaponFilter);
 	weaponList->setModelColumn(WeaponModel::Name);
 	weaponList->setSelectionMode(QAbstractItemView::SingleSelection);
+	weaponList->setUniformItemSizes(true);
 
 	QVBoxLayout *weaponListLayout = new QVBoxLayout;
 	weaponListLayout->addWidget(new QLabel(BTech::Strings::LabelAvailableWeapons));
+	weaponListLayout->addWidget(searchEdit);
 	weaponListLayout->addWidget(weaponList);
 
 	layout->addLayout(weaponListLayout);
@@ -237,7 +244,7 @@ void EditWeaponsDialog::initWidgetMapping()
 	mapper->addMapping(ammoPerTon, WeaponModel::AmmoPerTon);
 	mapper->addMapping(missilesPerShot, WeaponModel::MissilesPerShot);
 
-	connect(weaponList->selectionModel(), &QItemSelectionModel::currentRowChanged, mapper, &QDataWidgetMapper::setCurrentModelIndex);
+	connect(weaponList->selectionModel(), &QItemSelectionModel::currentRowChanged, this, &EditWeaponsDialog::onCurrentWeaponChanged);
 	connect(resetButton, &QPushButton::clicked, mapper, &QDataWidgetMapper::revert);
 }
 
@@ -251,6 +258,14 @@ void EditWeaponsDialog::adjustRangeThreshold(QSpinBox *shorter, QSpinBox *longer
 		shorter->setValue(qMin(valueLonger - 1, valueShorter));
 }
 
+/**
+ * Returns index of the selected weapon in WeaponModel, the list showing only the filtered ones.
+ */
+QModelIndex EditWeaponsDialog::currentWeaponIndex() const
+{
+	return weaponFilter->mapToSource(weaponList->selectionModel()->currentIndex());
+}
+
 void EditWeaponsDialog::addWeapon()
 {
 	WeaponModel::addNewWeapon();
@@ -258,7 +273,9 @@ void EditWeaponsDialog::addWeapon()
 
 void EditWeaponsDialog::removeWeapon()
 {
-	QModelIndex idx = weaponList->selectionModel()->currentIndex();
+	QModelIndex idx = currentWeaponIndex();
+	if (!idx.isValid())
+		return;
 	UID weaponUid = WeaponModel::getRow(idx.row())->getUid();
 	WeaponModel::removeWeapon(weaponUid);
 }
@@ -266,19 +283,24 @@ void EditWeaponsDialog::removeWeapon()
 void EditWeaponsDialog::saveWeapon()
 {
 	QString name = nameEdit->text().trimmed();
-	QModelIndex idx = weaponList->selectionModel()->currentIndex();
+	QModelIndex idx = currentWeaponIndex();
 	if (name.isEmpty()) {
 		statusBar->showMessage(BTech::Strings::ErrorWeaponNameEmpty, StatusBarMessageTimeoutMs);
 		return;
 	}
 
-	if (name != weaponList->model()->data(idx).toString() && WeaponModel::hasWeapon(name)) {
+	if (name != WeaponModel::getInstance().data(idx, Qt::DisplayRole).toString() && WeaponModel::hasWeapon(name)) {
 		statusBar->showMessage(BTech::Strings::ErrorWeaponNameExists, StatusBarMessageTimeoutMs);
 		return;
 	}
 	mapper->submit();
 }
 
+void EditWeaponsDialog::onCurrentWeaponChanged(const QModelIndex &index)
+{
+	mapper->setCurrentModelIndex(weaponFilter->mapToSource(index));
+}
+
 void EditWeaponsDialog::adjustRangeThresholds(quint8 spinBoxNumber)
 {
 	switch (spinBoxNumber) {
@@ -4,6 +4,7 @@
 #include <QtWidgets>
 #include "BTCommon/WeaponBase.h"
 #include "BTMapEditor/ManagersUtils.h"
+#include "BTMapEditor/dialogs/CatalogFilterModel.h"
 
 /**
  * \class ButtonGroup
@@ -58,6 +59,8 @@ private:
 	QSpinBox *ammoPerTon;
 	QSpinBox *missilesPerShot;
 
+	CatalogFilterModel *weaponFilter;
+	CatalogSearchEdit *searchEdit;
 	QListView *weaponList;
 
 	QDialogButtonBox *buttonBox;
@@ -79,6 +82,7 @@ private:
 	void initWidgetMapping();
 
 	void adjustRangeThreshold(QSpinBox *shorter, QSpinBox *longer, bool up);
+	QModelIndex currentWeaponIndex() const;
 
 	static const int MAX_SHORT_RANGE_SPIN_BOX  = 0;
 	static const int MAX_MEDIUM_RANGE_SPIN_BOX = 1;
@@ -88,6 +92,7 @@ private slots:
 	void addWeapon();
 	void removeWeapon();
 	void saveWeapon();
+	void onCurrentWeaponChanged(const QModelIndex &index);
 
 	void adjustRangeThresholds(quint8 spinBoxNumber);
 	void adjustEditability(quint8 radioButtonNumber);
@@ -1,6 +1,6 @@
 #include "BTCommon/MechBase.h"
-#include "BTCommon/MechPartBase.h"
 #include "BTCommon/WeaponBase.h"
+#include "BTMapEditor/dialogs/CatalogFilterModel.h"
 #include "BTMapEditor/dialogs/ItemComboBox.h"
 
 /**
@@ -22,86 +22,61 @@ void ComboBox::chooseItem()
 }
 
 /**
- * \class ItemsComboBox
+ * \class ItemComboBox
  */
 
-template <typename T>
-ItemComboBox <T>::ItemComboBox()
-{}
-
-template <typename T>
-void ItemComboBox <T>::clear()
+template <>
+const MechBase * ItemComboBox <const MechBase>::getItem(const QModelIndex &index)
 {
-	items.clear();
-	refresh();
+	return MechModel::getRow(index.row());
 }
 
-template <typename T>
-bool ItemComboBox <T>::isEmpty() const
+template <>
+const WeaponBase * ItemComboBox <const WeaponBase>::getItem(const QModelIndex &index)
 {
-	return items.isEmpty();
+	return WeaponModel::getWeapon(index);
 }
 
+/**
+ * Model may be a CatalogFilterModel, so the combo box shows only the filtered items.
+ */
 template <typename T>
-void ItemComboBox <T>::addItem(T *item)
+ItemComboBox <T>::ItemComboBox(QAbstractItemModel *model, int column)
 {
-	items.append(item);
-	QComboBox::addItem(static_cast<QString>(*item));
+	sortModel = new QSortFilterProxyModel(this);
+	sortModel->setSourceModel(model);
+	sortModel->setSortCaseSensitivity(Qt::CaseInsensitive);
+	sortModel->sort(column);
+
+	// measuring all items to fit the width would read every one of them; the width is fixed anyway
+	QComboBox::setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
+	QComboBox::setModel(sortModel);
+	QComboBox::setModelColumn(column);
+	if (QListView *listView = qobject_cast<QListView *>(QComboBox::view()))
+		listView->setUniformItemSizes(true);
 }
 
 template <typename T>
-void ItemComboBox <T>::removeItem(const T *item)
+bool ItemComboBox <T>::isEmpty() const
 {
-	for (typename QList <T *>::iterator it = items.begin(); it != items.end(); ++it) {
-		if (*it == item) {
-			items.erase(it);
-			return;
-		}
-	}
+	return QComboBox::count() == 0;
 }
 
 template <typename T>
 void ItemComboBox <T>::setCurrentItem(const T *item)
 {
-	for (int i = 0; i < items.size(); ++i)
-		if (items[i] == item)
-			QComboBox::setCurrentIndex(i);
+	QComboBox::setCurrentIndex(QComboBox::findText(static_cast<QString>(*item), Qt::MatchExactly));
 	ComboBox::chooseItem();
 }
 
-template <typename T>
-void ItemComboBox <T>::removeCurrentItem()
-{
-	items.removeAt(QComboBox::currentIndex());
-	QComboBox::removeItem(QComboBox::currentIndex());
-}
-
 template <typename T>
 T * ItemComboBox <T>::getCurrentItem() const
 {
-	if (isEmpty())
+	if (isEmpty() || QComboBox::currentIndex() < 0)
 		return nullptr;
-	return items[QComboBox::currentIndex()];
-}
-
-template <typename T>
-QList <T *> ItemComboBox <T>::getItems() const
-{
-	return items;
-}
-
-template <typename T>
-void ItemComboBox <T>::refresh()
-{
-	qSort(items.begin(), items.end(), [](const T *lhs, const T *rhs){
-		return QString(*lhs) < QString(*rhs);
-	});
-	QComboBox::clear();
-	for (T *item : items)
-		QComboBox::addItem(QString(*item));
-	ComboBox::chooseItem();
+	QModelIndex index = sortModel->index(QComboBox::currentIndex(), QComboBox::modelColumn());
+	return getItem(CatalogFilterModel::mapToBase(index));
 }
 
-template class ItemComboBox <MechBase>;
+template class ItemComboBox <const MechBase>;
 template class ItemComboBox <const WeaponBase>;
-template class ItemComboBox <MechPartBase>;
@@ -24,27 +24,23 @@ protected slots:
 
 /**
  * \class ItemComboBox
+ * Shows items of a model, sorted by name, without copying them; the combo box follows changes of the model.
  */
 template <typename T>
 class ItemComboBox : public ComboBox
 {
 public:
-	ItemComboBox();
+	ItemComboBox(QAbstractItemModel *model, int column);
 
-	void clear();
 	bool isEmpty() const;
 
-	void addItem(T *item);
-	void removeItem(const T *item);
 	void setCurrentItem(const T *item);
-	void removeCurrentItem();
 	T * getCurrentItem() const;
-	QList <T *> getItems() const;
 
 private:
-	QList <T *> items;
+	QSortFilterProxyModel *sortModel;
 
-	void refresh();
+	static T * getItem(const QModelIndex &index);
 };
 
 #endif // ITEMS_COMBO_BOX_H
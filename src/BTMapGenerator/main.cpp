@@ -0,0 +1,53 @@
+#include <QtCore>
+#include "BTCommon/DataManager.h"
+#include "BTCommon/MapGenerator.h"
+#include "BTCommon/Paths.h"
+
+/**
+ * Generates a map from the command line, e.g.
+ * BTMGenerator --width 1000 --height 1000 --seed 7 --players 4 big.btm
+ */
+int main(int argc, char **argv)
+{
+	QCoreApplication app(argc, argv);
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Generates a random BTech map of given size from a seed.");
+	parser.addHelpOption();
+	parser.addPositionalArgument("file", "Map file to write.");
+
+	MapGenerator::Parameters parameters;
+	QCommandLineOption widthOption("width", "Number of Hexes in a row.", "width", QString::number(parameters.width));
+	QCommandLineOption heightOption("height", "Number of Hexes in a column.", "height", QString::number(parameters.height));
+	QCommandLineOption seedOption("seed", "Seed of the map.", "seed", QString::number(parameters.seed));
+	QCommandLineOption playersOption("players", "Number of players.", "players", QString::number(parameters.players));
+	QCommandLineOption mechsOption("mechs", "Number of mechs of each player.", "mechs", QString::number(parameters.mechsPerPlayer));
+	QCommandLineOption maxHeightOption("max-height", "Height of the highest Hexes.", "height", QString::number(parameters.maxHeight));
+	QCommandLineOption dataOption("data", "Weapons and mechs data file.", "file", BTech::Paths::DATA_PATH);
+	parser.addOptions({widthOption, heightOption, seedOption, playersOption, mechsOption, maxHeightOption, dataOption});
+	parser.process(app);
+
+	if (parser.positionalArguments().size() != 1)
+		parser.showHelp(1);
+
+	parameters.width = parser.value(widthOption).toShort();
+	parameters.height = parser.value(heightOption).toShort();
+	parameters.seed = parser.value(seedOption).toUInt();
+	parameters.players = parser.value(playersOption).toInt();
+	parameters.mechsPerPlayer = parser.value(mechsOption).toInt();
+	parameters.maxHeight = parser.value(maxHeightOption).toInt();
+	if (parameters.width <= 0 || parameters.height <= 0 || parameters.players < 0 || parameters.mechsPerPlayer < 0) {
+		qCritical() << "Invalid map parameters";
+		return 1;
+	}
+
+	if (!DataManager::loadFromFile(parser.value(dataOption)))
+		qWarning() << "Could not load" << parser.value(dataOption) << "- players will have no units";
+
+	QString fileName = parser.positionalArguments().first();
+	if (!MapGenerator(parameters).generateToFile(fileName)) {
+		qCritical() << "Could not write" << fileName;
+		return 1;
+	}
+	return 0;
+}